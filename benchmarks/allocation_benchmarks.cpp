@@ -0,0 +1,70 @@
+#include "allocations.hpp"
+#include "types.hpp"
+#include <di.hpp>
+
+#include <benchmark/benchmark.h>
+#include <memory>
+
+// heap allocations per operation, reported as the allocs/bytes counters
+
+static void Benchmark_AllocsDepsGet(benchmark::State &state) {
+    A a;
+    B b;
+    auto deps = di::Deps<A, B>{ std::ref(a), std::ref(b) };
+    AllocationScope scope;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(deps.get<B>());
+    report_allocations(state, scope);
+}
+BENCHMARK(Benchmark_AllocsDepsGet);
+
+static void Benchmark_AllocsDepsNarrowing(benchmark::State &state) {
+    A a;
+    B b;
+    C c;
+    auto deps = di::Deps<A, B, C>{ std::ref(a), std::ref(b), std::ref(c) };
+    AllocationScope scope;
+    for(auto _ : state) {
+        di::Deps<A, const C> narrowed = deps;
+        benchmark::DoNotOptimize(narrowed);
+    }
+    report_allocations(state, scope);
+}
+BENCHMARK(Benchmark_AllocsDepsNarrowing);
+
+static void Benchmark_AllocsServicesConstruction(benchmark::State &state) {
+    AllocationScope scope;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(di::Services<A, B, C>());
+    report_allocations(state, scope);
+}
+BENCHMARK(Benchmark_AllocsServicesConstruction);
+
+static void Benchmark_AllocsServicesConstructionInArena(benchmark::State &state) {
+    AllocationScope scope;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(di::Services<A, B, C>(di::in_arena));
+    report_allocations(state, scope);
+}
+BENCHMARK(Benchmark_AllocsServicesConstructionInArena);
+
+static void Benchmark_AllocsLazyServicesConstruction(benchmark::State &state) {
+    AllocationScope scope;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(di::LazyServices<A, B, C>(
+            [] { return std::make_shared<A>(); },
+            [] { return std::make_shared<B>(); },
+            [] { return std::make_shared<C>(); }));
+    report_allocations(state, scope);
+}
+BENCHMARK(Benchmark_AllocsLazyServicesConstruction);
+
+static void Benchmark_AllocsLazyResolvedAccess(benchmark::State &state) {
+    auto services = di::LazyServices<A>{ [] { return A{}; } };
+    benchmark::DoNotOptimize(services.get<A>()->value);
+    AllocationScope scope;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(services.get<A>()->value);
+    report_allocations(state, scope);
+}
+BENCHMARK(Benchmark_AllocsLazyResolvedAccess);
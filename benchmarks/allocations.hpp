@@ -0,0 +1,14 @@
+#pragma once
+
+#include "../tests/allocations.hpp"
+
+#include <benchmark/benchmark.h>
+
+/**
+ * @brief Report the allocations counted by scope as per-iteration benchmark counters
+ */
+inline void report_allocations(benchmark::State &state, AllocationScope const &scope) {
+    auto const count         = scope.count();
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(count.allocations), benchmark::Counter::kAvgIterations);
+    state.counters["bytes"]  = benchmark::Counter(static_cast<double>(count.bytes), benchmark::Counter::kAvgIterations);
+}
@@ -0,0 +1,45 @@
+#include "threading.hpp"
+#include "types.hpp"
+#include <di.hpp>
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <future>
+
+static di::Task<> resolve(di::AsyncLazyServices<A> services, std::atomic<int> &remaining, std::promise<void> &done) {
+    benchmark::DoNotOptimize((co_await services.get<A>())->value);
+    if(--remaining == 0)
+        done.set_value();
+}
+
+// many coroutines awaiting the same (unresolved) service at once
+static void Benchmark_AsyncLazyConcurrentResolve(benchmark::State &state) {
+    auto const coroutines = static_cast<int>(state.range(0));
+    di::ThreadPool pool{ static_cast<std::size_t>(max_threads()) };
+
+    for(auto _ : state) {
+        std::atomic<int> remaining = coroutines;
+        std::promise<void> done;
+        auto services = di::AsyncLazyServices<A>{ [&pool]() -> di::Task<A> {
+            co_await di::schedule(pool);
+            co_return A{};
+        } };
+
+        for(auto i = 0; i < coroutines; ++i)
+            di::spawn(pool, resolve(services, remaining, done));
+        done.get_future().wait();
+    }
+    state.SetItemsProcessed(state.iterations() * coroutines);
+}
+BENCHMARK(Benchmark_AsyncLazyConcurrentResolve)->RangeMultiplier(8)->Range(1, 4096)->UseRealTime();
+
+static void Benchmark_AsyncLazyResolvedAwait(benchmark::State &state) {
+    auto services = di::AsyncLazyServices<A>{ std::make_shared<A>() };
+    auto holder   = services.get<A>();
+
+    for(auto _ : state)
+        benchmark::DoNotOptimize(di::sync_wait([](di::AsyncLazyHolder<A> const &holder) -> di::Task<int> {
+            co_return(co_await holder)->value;
+        }(holder)));
+}
+BENCHMARK(Benchmark_AsyncLazyResolvedAwait);
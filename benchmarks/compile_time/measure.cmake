@@ -0,0 +1,76 @@
+# Usage: cmake -D CXX=<compiler> -D INCLUDE_DIR=<src> -D OUTPUT_DIR=<dir> -D SIZES=10,50 [-D TIME_EXECUTABLE=/usr/bin/time] -P measure.cmake
+cmake_minimum_required ( VERSION 3.23 ) # TIMESTAMP %f
+
+string ( REPLACE "," ";" SIZES "${SIZES}" )
+set ( REPORT "${OUTPUT_DIR}/compile_times.csv" )
+file ( WRITE ${REPORT} "types,seconds,peak_kb\n" )
+
+foreach ( N IN LISTS SIZES )
+    # N distinct services, default-constructed, queried, narrowed and recombined
+    math ( EXPR LAST "${N} - 1" )
+    math ( EXPR HALF "${N} / 2" )
+    math ( EXPR HALF_LAST "${HALF} - 1" )
+    set ( ALL "" )
+    set ( LOWER "" )
+    set ( UPPER "" )
+    foreach ( I RANGE ${LAST} )
+        list ( APPEND ALL "S<${I}>" )
+        if ( I LESS HALF )
+            list ( APPEND LOWER "S<${I}>" )
+        else ()
+            list ( APPEND UPPER "S<${I}>" )
+        endif ()
+    endforeach ()
+    list ( JOIN ALL ", " ALL )
+    list ( JOIN LOWER ", " LOWER )
+    list ( JOIN UPPER ", " UPPER )
+
+    set ( SOURCE "${OUTPUT_DIR}/selection_${N}.cpp" )
+    file ( WRITE ${SOURCE} "#include <di.hpp>
+
+template <int N>
+struct S {
+    int value = N;
+};
+
+using all_t = di::Services<${ALL}>;
+
+int main() {
+    all_t all;
+    di::Services<S<0>, S<${HALF}>, const S<${LAST}>> narrowed = all;
+    auto combined = di::combine(di::Services<${LOWER}>{ all }, di::Services<${UPPER}>{ all });
+    return all.get<S<0>>()->value + all.get<S<${HALF_LAST}>>()->value + all.get<const S<${LAST}>>()->value
+        + narrowed.get<S<${HALF}>>()->value + combined.get<S<${LAST}>>()->value;
+}
+" )
+
+    set ( COMPILE ${CXX} -std=c++20 -I${INCLUDE_DIR} -c ${SOURCE} -o ${SOURCE}.o )
+    set ( MEMORY_FILE "${OUTPUT_DIR}/selection_${N}.mem" )
+    if ( TIME_EXECUTABLE )
+        set ( COMPILE ${TIME_EXECUTABLE} -f "%M" -o ${MEMORY_FILE} ${COMPILE} )
+    endif ()
+
+    string ( TIMESTAMP START "%s%f" )
+    execute_process ( COMMAND ${COMPILE} RESULT_VARIABLE FAILED ERROR_VARIABLE ERRORS )
+    string ( TIMESTAMP STOP "%s%f" )
+    if ( FAILED )
+        message ( FATAL_ERROR "Selection of ${N} types failed to compile:\n${ERRORS}" )
+    endif ()
+
+    math ( EXPR MICROS "${STOP} - ${START}" )
+    math ( EXPR SECONDS "${MICROS} / 1000000" )
+    math ( EXPR MILLIS "(${MICROS} / 1000) % 1000" )
+    string ( LENGTH "00${MILLIS}" PADDED_LENGTH )
+    math ( EXPR PADDED_START "${PADDED_LENGTH} - 3" )
+    string ( SUBSTRING "00${MILLIS}" ${PADDED_START} 3 MILLIS )
+
+    set ( PEAK "n/a" )
+    if ( EXISTS ${MEMORY_FILE} )
+        file ( STRINGS ${MEMORY_FILE} PEAK REGEX "^[0-9]+$" )
+    endif ()
+
+    message ( STATUS "${N} types: ${SECONDS}.${MILLIS} s, peak ${PEAK} KB" )
+    file ( APPEND ${REPORT} "${N},${SECONDS}.${MILLIS},${PEAK}\n" )
+endforeach ()
+
+message ( STATUS "Report written to ${REPORT}" )
@@ -0,0 +1,137 @@
+#include "../threading.hpp"
+#include "../types.hpp"
+#include "latency.hpp"
+#include <di.hpp>
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+// Every benchmark runs on 1..hardware_concurrency threads. "Contended" cases
+// share one selection (and thus the same holders and control blocks) between
+// all threads, "sharded" cases give each thread a selection of its own.
+
+namespace {
+
+struct User {
+    using services_t = di::Services<A, B, const C>;
+    User(services_t services)
+        : services_{ services } {}
+    services_t services_;
+};
+
+di::LazyServices<A, B, C, D> make_lazy() {
+    return di::LazyServices<A, B, C, D>{
+        [] { return std::make_shared<A>(); },
+        [] { return std::make_shared<B>(); },
+        [] { return std::make_shared<C>(); },
+        [] { return std::make_shared<D>(); },
+    };
+}
+
+// amount of unresolved holders each thread walks through
+constexpr int unresolved_count = 20000;
+
+} // namespace
+
+static void Benchmark_ServicesGetContended(benchmark::State &state) {
+    static auto services = di::Services<A, B, C, D>{};
+    run_sampled(state, [] { benchmark::DoNotOptimize(services.get<B>()); });
+}
+BENCHMARK(Benchmark_ServicesGetContended)->ThreadRange(1, max_threads())->UseRealTime();
+
+static void Benchmark_ServicesGetSharded(benchmark::State &state) {
+    auto services = di::Services<A, B, C, D>{};
+    run_sampled(state, [&] { benchmark::DoNotOptimize(services.get<B>()); });
+}
+BENCHMARK(Benchmark_ServicesGetSharded)->ThreadRange(1, max_threads())->UseRealTime();
+
+static void Benchmark_DepsGetContended(benchmark::State &state) {
+    static A a;
+    static B b;
+    static auto deps = di::Deps<A, B>{ std::ref(a), std::ref(b) };
+    run_sampled(state, [] { benchmark::DoNotOptimize(deps.get<B>()); });
+}
+BENCHMARK(Benchmark_DepsGetContended)->ThreadRange(1, max_threads())->UseRealTime();
+
+static void Benchmark_ServicesNarrowingContended(benchmark::State &state) {
+    static auto services = di::Services<A, B, C, D>{};
+    run_sampled(state, [] {
+        di::Services<A, const C> narrowed = services;
+        benchmark::DoNotOptimize(narrowed);
+    });
+}
+BENCHMARK(Benchmark_ServicesNarrowingContended)->ThreadRange(1, max_threads())->UseRealTime();
+
+static void Benchmark_ServicesNarrowingSharded(benchmark::State &state) {
+    auto services = di::Services<A, B, C, D>{};
+    run_sampled(state, [&] {
+        di::Services<A, const C> narrowed = services;
+        benchmark::DoNotOptimize(narrowed);
+    });
+}
+BENCHMARK(Benchmark_ServicesNarrowingSharded)->ThreadRange(1, max_threads())->UseRealTime();
+
+static void Benchmark_ServicesPassingContended(benchmark::State &state) {
+    static auto services = di::Services<A, B, C, D>{};
+    run_sampled(state, [] {
+        User user{ services };
+        benchmark::DoNotOptimize(user);
+    });
+}
+BENCHMARK(Benchmark_ServicesPassingContended)->ThreadRange(1, max_threads())->UseRealTime();
+
+static void Benchmark_ServicesPassingSharded(benchmark::State &state) {
+    auto services = di::Services<A, B, C, D>{};
+    run_sampled(state, [&] {
+        User user{ services };
+        benchmark::DoNotOptimize(user);
+    });
+}
+BENCHMARK(Benchmark_ServicesPassingSharded)->ThreadRange(1, max_threads())->UseRealTime();
+
+static void Benchmark_LazyGetContended(benchmark::State &state) {
+    static auto services = make_lazy();
+    run_sampled(state, [] { benchmark::DoNotOptimize(services.get<B>()); });
+}
+BENCHMARK(Benchmark_LazyGetContended)->ThreadRange(1, max_threads())->UseRealTime();
+
+// all threads on one resolved lazy service
+static void Benchmark_LazyResolvedArrowContended(benchmark::State &state) {
+    static auto services = make_lazy();
+    auto holder          = services.get<A>();
+    run_sampled(state, [&] { benchmark::DoNotOptimize(holder->value); });
+}
+BENCHMARK(Benchmark_LazyResolvedArrowContended)->ThreadRange(1, max_threads())->UseRealTime();
+
+static void Benchmark_LazyResolvedArrowSharded(benchmark::State &state) {
+    auto services = make_lazy();
+    auto holder   = services.get<A>();
+    run_sampled(state, [&] { benchmark::DoNotOptimize(holder->value); });
+}
+BENCHMARK(Benchmark_LazyResolvedArrowSharded)->ThreadRange(1, max_threads())->UseRealTime();
+
+// all threads race to resolve the same fresh holders, one per iteration
+static void Benchmark_LazyUnresolvedArrowContended(benchmark::State &state) {
+    static std::vector<di::LazyHolder<A>> holders;
+    if(state.thread_index() == 0) {
+        // runs before the other threads pass the start barrier
+        holders.clear();
+        for(auto i = 0; i < unresolved_count; ++i)
+            holders.emplace_back([] { return std::make_shared<A>(); });
+    }
+
+    std::size_t i = 0;
+    run_sampled(state, [&] { benchmark::DoNotOptimize(holders[i++]->value); });
+}
+BENCHMARK(Benchmark_LazyUnresolvedArrowContended)->ThreadRange(1, max_threads())->Iterations(unresolved_count)->UseRealTime();
+
+static void Benchmark_LazyUnresolvedArrowSharded(benchmark::State &state) {
+    std::vector<di::LazyHolder<A>> holders;
+    for(auto i = 0; i < unresolved_count; ++i)
+        holders.emplace_back([] { return std::make_shared<A>(); });
+
+    std::size_t i = 0;
+    run_sampled(state, [&] { benchmark::DoNotOptimize(holders[i++]->value); });
+}
+BENCHMARK(Benchmark_LazyUnresolvedArrowSharded)->ThreadRange(1, max_threads())->Iterations(unresolved_count)->UseRealTime();
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Samples the latency of every Nth operation of a benchmark thread
+ * 
+ * Reports the 50th, 99th and 99.9th percentile (in ns) of the sampled
+ * operations as counters averaged over threads. Each sample includes
+ * the overhead of reading the clock twice.
+ */
+class LatencySampler {
+    using clock = std::chrono::steady_clock;
+
+    std::vector<std::int64_t> samples_;
+    std::size_t every_;
+    std::size_t count_ = 0;
+
+public:
+    explicit LatencySampler(std::size_t every = 64)
+        : every_{ every } {
+        samples_.reserve(1 << 16);
+    }
+
+    template <typename Fn>
+    void run(Fn &&op) {
+        if(count_++ % every_ != 0) {
+            op();
+            return;
+        }
+
+        auto const start = clock::now();
+        op();
+        auto const stop = clock::now();
+        samples_.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+    }
+
+    void report(benchmark::State &state) {
+        if(samples_.empty())
+            return;
+
+        std::sort(samples_.begin(), samples_.end());
+        auto const percentile = [this](double p) {
+            auto const index = static_cast<std::size_t>(p * static_cast<double>(samples_.size()));
+            return static_cast<double>(samples_[std::min(index, samples_.size() - 1)]);
+        };
+        state.counters["p50_ns"]  = benchmark::Counter(percentile(0.5), benchmark::Counter::kAvgThreads);
+        state.counters["p99_ns"]  = benchmark::Counter(percentile(0.99), benchmark::Counter::kAvgThreads);
+        state.counters["p999_ns"] = benchmark::Counter(percentile(0.999), benchmark::Counter::kAvgThreads);
+    }
+};
+
+/**
+ * @brief Runs op for each iteration, reporting throughput and sampled tail latency
+ */
+template <typename Fn>
+void run_sampled(benchmark::State &state, Fn &&op) {
+    LatencySampler sampler;
+    for(auto _ : state)
+        sampler.run(op);
+    sampler.report(state);
+    state.SetItemsProcessed(state.iterations());
+}
@@ -0,0 +1,100 @@
+#include <di.hpp>
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+// A layered graph of 200 services: 20 layers of 10, each service depending
+// on two services of the previous layer.
+static constexpr std::size_t layer_width = 10;
+static constexpr std::size_t node_count  = 200;
+
+template <std::size_t N, bool Leaf = (N < layer_width)>
+struct Node {
+    std::size_t value = N;
+};
+
+template <std::size_t N>
+struct Node<N, false> {
+    static constexpr std::size_t first  = N - layer_width;
+    static constexpr std::size_t second = N - N % layer_width - layer_width + (N + 1) % layer_width;
+
+    using services_t = di::Services<const Node<first>, const Node<second>>;
+    Node(services_t services)
+        : services_{ services } {}
+
+    services_t services_;
+    std::size_t value = N;
+};
+
+template <std::size_t... Is>
+static auto graph_roots(std::index_sequence<Is...>) -> di::Injector<Node<node_count - layer_width + Is>...>;
+
+using graph_injector_t = decltype(graph_roots(std::make_index_sequence<layer_width>{}));
+
+template <std::size_t N>
+static auto wire(auto const &built) {
+    if constexpr(N < layer_width)
+        return std::make_shared<Node<N>>();
+    else
+        return std::make_shared<Node<N>>(typename Node<N>::services_t{
+            std::get<Node<N>::first>(built),
+            std::get<Node<N>::second>(built) });
+}
+
+// what one would write by hand: construct every node in index order
+template <std::size_t... Is>
+static auto hand_wired(std::index_sequence<Is...>) {
+    auto built = std::tuple<std::shared_ptr<Node<Is>>...>{};
+    ((std::get<Is>(built) = wire<Is>(built)), ...);
+    return built;
+}
+
+static void Benchmark_HandWiredStartup(benchmark::State &state) {
+    for(auto _ : state)
+        benchmark::DoNotOptimize(hand_wired(std::make_index_sequence<node_count>{}));
+}
+BENCHMARK(Benchmark_HandWiredStartup);
+
+static void Benchmark_InjectorStartup(benchmark::State &state) {
+    for(auto _ : state)
+        benchmark::DoNotOptimize(graph_injector_t::build());
+}
+BENCHMARK(Benchmark_InjectorStartup);
+
+// A layered graph of 32 services (4 layers of 8) whose constructors
+// block for a millisecond, e.g. doing I/O.
+static constexpr std::size_t sleepy_width = 8;
+static constexpr std::size_t sleepy_count = 32;
+
+template <std::size_t N, bool Leaf = (N < sleepy_width)>
+struct Sleepy {
+    Sleepy() { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }
+};
+
+template <std::size_t N>
+struct Sleepy<N, false> {
+    using services_t = di::Services<const Sleepy<N - sleepy_width>,
+        const Sleepy<N - N % sleepy_width - sleepy_width + (N + 1) % sleepy_width>>;
+    Sleepy(services_t) { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }
+};
+
+template <std::size_t... Is>
+static auto sleepy_roots(std::index_sequence<Is...>) -> di::Injector<Sleepy<sleepy_count - sleepy_width + Is>...>;
+
+using sleepy_injector_t = decltype(sleepy_roots(std::make_index_sequence<sleepy_width>{}));
+
+static void Benchmark_SleepyStartupSequential(benchmark::State &state) {
+    for(auto _ : state)
+        benchmark::DoNotOptimize(sleepy_injector_t::build());
+}
+BENCHMARK(Benchmark_SleepyStartupSequential)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void Benchmark_SleepyStartupParallel(benchmark::State &state) {
+    di::ThreadPool pool{ static_cast<std::size_t>(state.range(0)) };
+    for(auto _ : state)
+        benchmark::DoNotOptimize(sleepy_injector_t::build(pool));
+}
+BENCHMARK(Benchmark_SleepyStartupParallel)->RangeMultiplier(2)->Range(1, sleepy_width)->Unit(benchmark::kMillisecond)->UseRealTime();
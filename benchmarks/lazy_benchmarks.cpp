@@ -0,0 +1,148 @@
+#include "threading.hpp"
+#include "types.hpp"
+#include <di.hpp>
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <variant>
+
+// The previous LazyHolder design: std::function factory in a shared variant
+// guarded by one mutex per type. Kept here as a baseline.
+template <typename T>
+class LegacyLazyHolder {
+    using ptr_t     = std::shared_ptr<T>;
+    using factory_t = std::function<ptr_t()>;
+    using variant_t = std::variant<ptr_t, factory_t>;
+
+    std::shared_ptr<variant_t> data_;
+    inline static std::mutex mtx_;
+
+public:
+    template <typename Fn>
+    LegacyLazyHolder(Fn factory)
+        : data_{ std::make_shared<variant_t>(factory) } {}
+
+    ptr_t operator->() {
+        std::lock_guard<std::mutex> g(mtx_);
+        if(auto ptr = std::get_if<ptr_t>(data_.get()))
+            return *ptr;
+        auto factory = std::get<factory_t>(*data_);
+        return data_->template emplace<ptr_t>(factory());
+    }
+};
+
+template <typename... Types>
+using LegacyLazyServices = di::Selection<LegacyLazyHolder, Types...>;
+
+static void Benchmark_LegacyLazyServiceCreation(benchmark::State &state) {
+    for(auto _ : state)
+        benchmark::DoNotOptimize(LegacyLazyServices<A, B, C>(
+            [] { return std::make_shared<A>(); },
+            [] { return std::make_shared<B>(); },
+            [] { return std::make_shared<C>(); }));
+}
+BENCHMARK(Benchmark_LegacyLazyServiceCreation);
+
+static void Benchmark_LazyServiceCreationFromValueFactories(benchmark::State &state) {
+    for(auto _ : state)
+        benchmark::DoNotOptimize(di::LazyServices<A, B, C>(
+            [] { return A{}; },
+            [] { return B{}; },
+            [] { return C{}; }));
+}
+BENCHMARK(Benchmark_LazyServiceCreationFromValueFactories);
+
+static void Benchmark_LegacyLazyServiceFirstAccess(benchmark::State &state) {
+    for(auto _ : state) {
+        auto services = LegacyLazyServices<A, B, C>(
+            [] { return std::make_shared<A>(); },
+            [] { return std::make_shared<B>(); },
+            [] { return std::make_shared<C>(); });
+        benchmark::DoNotOptimize(services.get<A>()->value);
+        benchmark::DoNotOptimize(services.get<B>()->value);
+        benchmark::DoNotOptimize(services.get<C>()->value);
+    }
+}
+BENCHMARK(Benchmark_LegacyLazyServiceFirstAccess);
+
+static void Benchmark_LazyServiceFirstAccess(benchmark::State &state) {
+    for(auto _ : state) {
+        auto services = di::LazyServices<A, B, C>(
+            [] { return std::make_shared<A>(); },
+            [] { return std::make_shared<B>(); },
+            [] { return std::make_shared<C>(); });
+        benchmark::DoNotOptimize(services.get<A>()->value);
+        benchmark::DoNotOptimize(services.get<B>()->value);
+        benchmark::DoNotOptimize(services.get<C>()->value);
+    }
+}
+BENCHMARK(Benchmark_LazyServiceFirstAccess);
+
+static void Benchmark_LazyServiceFirstAccessFromValueFactories(benchmark::State &state) {
+    for(auto _ : state) {
+        auto services = di::LazyServices<A, B, C>(
+            [] { return A{}; },
+            [] { return B{}; },
+            [] { return C{}; });
+        benchmark::DoNotOptimize(services.get<A>()->value);
+        benchmark::DoNotOptimize(services.get<B>()->value);
+        benchmark::DoNotOptimize(services.get<C>()->value);
+    }
+}
+BENCHMARK(Benchmark_LazyServiceFirstAccessFromValueFactories);
+
+static void Benchmark_LazyResolvedAccess(benchmark::State &state) {
+    auto services = di::LazyServices<A>{ [] { return std::make_shared<A>(); } };
+    [[maybe_unused]] auto _ = services.get<A>()->value; // resolve upfront
+
+    for(auto _ : state)
+        benchmark::DoNotOptimize(services.get<A>()->value);
+}
+BENCHMARK(Benchmark_LazyResolvedAccess);
+
+// all threads hammer the same resolved lazy service
+static void Benchmark_LazyContendedAccess(benchmark::State &state) {
+    static auto services = di::LazyServices<A>{ [] { return std::make_shared<A>(); } };
+    auto holder          = services.get<A>();
+
+    for(auto _ : state)
+        benchmark::DoNotOptimize(holder->value);
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Benchmark_LazyContendedAccess)->ThreadRange(1, max_threads())->UseRealTime();
+
+static void Benchmark_LazyContendedSharedGet(benchmark::State &state) {
+    static auto services = di::LazyServices<A>{ [] { return std::make_shared<A>(); } };
+    auto holder          = services.get<A>();
+
+    for(auto _ : state)
+        benchmark::DoNotOptimize(holder.get());
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Benchmark_LazyContendedSharedGet)->ThreadRange(1, max_threads())->UseRealTime();
+
+// latency of the first request to an expensive lazy service,
+// with and without warming it up during (idle) startup
+static void Benchmark_LazyFirstRequestLatency(benchmark::State &state) {
+    auto const warm = state.range(0) != 0;
+    di::ThreadPool pool{ 1 };
+
+    for(auto _ : state) {
+        state.PauseTiming();
+        auto services = di::LazyServices<A>{ [] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            return A{};
+        } };
+        if(warm)
+            di::warm_up(services, pool).wait();
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(services.get<A>()->value);
+    }
+}
+BENCHMARK(Benchmark_LazyFirstRequestLatency)->ArgName("warm_up")->Arg(0)->Arg(1)->Iterations(200)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,53 @@
+#include "types.hpp"
+#include <di.hpp>
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <type_traits>
+
+// Without DI_LAZY_STATS (the default build) the probes are empty and LazyHolder
+// must be as fast as an uninstrumented holder; compare with the
+// LazyStatsEnabled benchmarks for the cost of recording.
+
+#if not defined(DI_LAZY_STATS)
+static_assert(std::is_empty_v<di::detail::lazy_probe<A>>);
+#endif
+
+// Uninstrumented baseline: the same acquire load on a published pointer
+struct BareLazy {
+    std::atomic<bool> ready = false;
+    A *instance             = nullptr;
+    std::unique_ptr<A> owner;
+
+    A *operator->() {
+        if(not ready.load(std::memory_order_acquire)) {
+            owner    = std::make_unique<A>();
+            instance = owner.get();
+            ready.store(true, std::memory_order_release);
+        }
+        return instance;
+    }
+};
+
+static void Benchmark_LazyStatsBaselineAccess(benchmark::State &state) {
+    BareLazy lazy;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(lazy->value);
+}
+BENCHMARK(Benchmark_LazyStatsBaselineAccess);
+
+static void Benchmark_LazyStatsDisabledAccess(benchmark::State &state) {
+    auto holder = di::LazyHolder<A>{ [] { return A{}; } };
+    for(auto _ : state)
+        benchmark::DoNotOptimize(holder->value);
+}
+BENCHMARK(Benchmark_LazyStatsDisabledAccess);
+
+static void Benchmark_LazyStatsDisabledFirstAccess(benchmark::State &state) {
+    for(auto _ : state) {
+        auto holder = di::LazyHolder<A>{ [] { return A{}; } };
+        benchmark::DoNotOptimize(holder->value);
+    }
+}
+BENCHMARK(Benchmark_LazyStatsDisabledFirstAccess);
@@ -0,0 +1,28 @@
+// built as its own executable with DI_LAZY_STATS defined (see CMakeLists.txt)
+
+#include <di.hpp>
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+struct Recorded {
+    int value = 0;
+};
+
+} // namespace
+
+static void Benchmark_LazyStatsEnabledAccess(benchmark::State &state) {
+    auto holder = di::LazyHolder<Recorded>{ [] { return Recorded{}; } };
+    for(auto _ : state)
+        benchmark::DoNotOptimize(holder->value);
+}
+BENCHMARK(Benchmark_LazyStatsEnabledAccess);
+
+static void Benchmark_LazyStatsEnabledFirstAccess(benchmark::State &state) {
+    for(auto _ : state) {
+        auto holder = di::LazyHolder<Recorded>{ [] { return Recorded{}; } };
+        benchmark::DoNotOptimize(holder->value);
+    }
+}
+BENCHMARK(Benchmark_LazyStatsEnabledFirstAccess);
@@ -0,0 +1,46 @@
+#include "threading.hpp"
+#include <di.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+// stands in for a hash state with large lookup tables
+struct Hasher {
+    std::vector<std::uint32_t> table = std::vector<std::uint32_t>(16 * 1024);
+    std::uint32_t state              = 0;
+
+    Hasher() { std::iota(table.begin(), table.end(), 0x9e3779b9u); }
+
+    std::uint32_t hash(std::uint32_t value) {
+        state = (state ^ table[value % table.size()]) * 16777619u;
+        return state;
+    }
+};
+
+} // namespace
+
+static void Benchmark_SharedPtrChurn(benchmark::State &state) {
+    std::uint32_t i = 0;
+    for(auto _ : state) {
+        auto hasher = std::make_shared<Hasher>();
+        benchmark::DoNotOptimize(hasher->hash(i++));
+    }
+}
+BENCHMARK(Benchmark_SharedPtrChurn)->ThreadRange(1, max_threads())->UseRealTime();
+
+static void Benchmark_PooledChurn(benchmark::State &state) {
+    static auto services = di::PooledServices<Hasher>{ di::PooledHolder<Hasher>{ di::PoolOptions{
+        .capacity = 4 * static_cast<std::size_t>(max_threads()),
+        .prefill  = static_cast<std::size_t>(max_threads()) } } };
+    auto holder = services.get<Hasher>();
+
+    std::uint32_t i = 0;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(holder->hash(i++));
+}
+BENCHMARK(Benchmark_PooledChurn)->ThreadRange(1, max_threads())->UseRealTime();
@@ -0,0 +1,54 @@
+#include "threading.hpp"
+#include <di.hpp>
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+
+namespace {
+
+// stands in for a routing table read by every request
+struct Routes {
+    std::array<std::uint32_t, 256> targets{};
+    Routes() {
+        for(std::uint32_t i = 0; i < targets.size(); ++i)
+            targets[i] = i * 2654435761u;
+    }
+
+    std::uint32_t route(std::uint32_t key) const {
+        return targets[key % targets.size()];
+    }
+};
+
+} // namespace
+
+// each request gets the table from its services, then reads it
+
+static void Benchmark_SharedConstServiceReads(benchmark::State &state) {
+    static auto services = di::Services<const Routes>{ std::make_shared<Routes const>() };
+
+    std::uint32_t i = 0;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(services.get<Routes>()->route(i++));
+}
+BENCHMARK(Benchmark_SharedConstServiceReads)->ThreadRange(1, max_threads())->UseRealTime();
+
+static void Benchmark_ReplicatedServiceReads(benchmark::State &state) {
+    static auto services = di::ReplicatedServices<const Routes>{ di::ReplicatedHolder<const Routes>{ Routes{} } };
+
+    std::uint32_t i = 0;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(services.get<Routes>()->route(i++));
+}
+BENCHMARK(Benchmark_ReplicatedServiceReads)->ThreadRange(1, max_threads())->UseRealTime();
+
+static void Benchmark_ReplicatedServiceReadsByThread(benchmark::State &state) {
+    static auto services = di::ReplicatedServices<const Routes>{ di::ReplicatedHolder<const Routes>{
+        Routes{}, di::ReplicaOptions{ .shards = static_cast<std::size_t>(max_threads()), .by = di::ReplicaBy::thread } } };
+
+    std::uint32_t i = 0;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(services.get<Routes>()->route(i++));
+}
+BENCHMARK(Benchmark_ReplicatedServiceReadsByThread)->ThreadRange(1, max_threads())->UseRealTime();
@@ -0,0 +1,51 @@
+#include "types.hpp"
+#include <di.hpp>
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <utility>
+
+// a request: combine singletons with 10 fresh per-request services, use them, drop them
+template <typename Request>
+static void handle(Request const &request) {
+    benchmark::DoNotOptimize(request.template get<A>()->value);
+    benchmark::DoNotOptimize(request.template get<Small<0>>()->value);
+    benchmark::DoNotOptimize(request.template get<Small<9>>()->value);
+}
+
+template <std::size_t... Is>
+static auto scoped_smalls(di::Scope &scope, std::index_sequence<Is...>) {
+    return scope.services<Small<Is>...>();
+}
+
+static void Benchmark_RequestWithSharedServices(benchmark::State &state) {
+    auto singletons = di::Services<A, B, const C>{};
+    for(auto _ : state)
+        handle(di::combine(singletons, many_small_t<di::Services, 10>()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Benchmark_RequestWithSharedServices);
+
+static void Benchmark_RequestWithScopedServices(benchmark::State &state) {
+    auto singletons = di::Services<A, B, const C>{};
+    auto scope      = di::Scope{};
+    for(auto _ : state) {
+        handle(di::combine(singletons, scoped_smalls(scope, std::make_index_sequence<10>{})));
+        scope.reset();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Benchmark_RequestWithScopedServices);
+
+static void Benchmark_RequestWithScopedServicesInBuffer(benchmark::State &state) {
+    alignas(std::max_align_t) std::array<std::byte, 8192> buffer;
+    auto singletons = di::Services<A, B, const C>{};
+    auto scope      = di::Scope{ buffer };
+    for(auto _ : state) {
+        handle(di::combine(singletons, scoped_smalls(scope, std::make_index_sequence<10>{})));
+        scope.reset();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Benchmark_RequestWithScopedServicesInBuffer);
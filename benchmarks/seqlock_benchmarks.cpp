@@ -0,0 +1,67 @@
+#include <di.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+
+// One writer (thread 0) and N readers of a small mutable service; items/s
+// counts the reads only.
+
+namespace {
+
+struct Limits {
+    std::int64_t per_second = 10;
+    std::int64_t burst      = 20;
+};
+
+struct SharedMutexLimits {
+    mutable std::shared_mutex mtx;
+    Limits limits;
+
+    Limits load() const {
+        std::shared_lock<std::shared_mutex> g(mtx);
+        return limits;
+    }
+
+    void bump() {
+        std::unique_lock<std::shared_mutex> g(mtx);
+        ++limits.per_second;
+    }
+};
+
+} // namespace
+
+static void Benchmark_SeqLockService(benchmark::State &state) {
+    static auto services = di::SeqLockServices<Limits>{};
+    auto holder          = services.get<Limits>();
+
+    std::int64_t reads = 0;
+    for(auto _ : state) {
+        if(state.thread_index() == 0) {
+            holder.update([](Limits &l) { ++l.per_second; });
+        } else {
+            benchmark::DoNotOptimize(holder.load());
+            ++reads;
+        }
+    }
+    state.SetItemsProcessed(reads);
+}
+BENCHMARK(Benchmark_SeqLockService)->ThreadRange(2, 64)->UseRealTime();
+
+static void Benchmark_SharedMutexService(benchmark::State &state) {
+    static auto services = di::Services<SharedMutexLimits>{};
+    auto holder          = services.get<SharedMutexLimits>();
+
+    std::int64_t reads = 0;
+    for(auto _ : state) {
+        if(state.thread_index() == 0) {
+            holder->bump();
+        } else {
+            benchmark::DoNotOptimize(holder->load());
+            ++reads;
+        }
+    }
+    state.SetItemsProcessed(reads);
+}
+BENCHMARK(Benchmark_SharedMutexService)->ThreadRange(2, 64)->UseRealTime();
@@ -1,23 +1,10 @@
+#include "types.hpp"
 #include <di.hpp>
 
 #include <benchmark/benchmark.h>
 #include <string>
 
 // todo: need to run each benchmark multiple times to produce avg
-// todo2: threads?
-
-struct A {
-    int value = 1234;
-};
-struct B {
-    bool value = false;
-};
-struct C {
-    std::string value = "Unchanged";
-};
-struct D {
-    float value = 0.42f;
-};
 
 struct User {
     using services_t = di::Services<A, B, const C>;
@@ -26,6 +13,13 @@ struct User {
     services_t services_;
 };
 
+struct LocalUser {
+    using services_t = di::LocalServices<A, B, const C>;
+    LocalUser(services_t services)
+        : services_{ services } {}
+    services_t services_;
+};
+
 struct DepsUser {
     using services_t = di::Deps<A, B, const C>;
     DepsUser(services_t services)
@@ -55,12 +49,41 @@ struct PtrUser {
     std::shared_ptr<const C> c_;
 };
 
+struct LocalPtrUser {
+    LocalPtrUser(di::LocalPtr<A> a, di::LocalPtr<B> b, di::LocalPtr<const C> c)
+        : a_{ a }
+        , b_{ b }
+        , c_{ c } {}
+
+    di::LocalPtr<A> a_;
+    di::LocalPtr<B> b_;
+    di::LocalPtr<const C> c_;
+};
+
 static void Benchmark_ServiceCreation(benchmark::State &state) {
     for(auto _ : state)
         benchmark::DoNotOptimize(di::Services<A, B, C>());
 }
 BENCHMARK(Benchmark_ServiceCreation);
 
+template <std::size_t N>
+static void Benchmark_ManyServiceCreation(benchmark::State &state) {
+    for(auto _ : state)
+        benchmark::DoNotOptimize(many_small_t<di::Services, N>());
+}
+BENCHMARK_TEMPLATE(Benchmark_ManyServiceCreation, 4);
+BENCHMARK_TEMPLATE(Benchmark_ManyServiceCreation, 16);
+BENCHMARK_TEMPLATE(Benchmark_ManyServiceCreation, 64);
+
+template <std::size_t N>
+static void Benchmark_ManyServiceCreationInArena(benchmark::State &state) {
+    for(auto _ : state)
+        benchmark::DoNotOptimize(many_small_t<di::Services, N>(di::in_arena));
+}
+BENCHMARK_TEMPLATE(Benchmark_ManyServiceCreationInArena, 4);
+BENCHMARK_TEMPLATE(Benchmark_ManyServiceCreationInArena, 16);
+BENCHMARK_TEMPLATE(Benchmark_ManyServiceCreationInArena, 64);
+
 static void Benchmark_LazyServiceCreation(benchmark::State &state) {
     for(auto _ : state)
         benchmark::DoNotOptimize(di::LazyServices<A, B, C>(
@@ -96,6 +119,14 @@ static void Benchmark_ServicePassing(benchmark::State &state) {
 }
 BENCHMARK(Benchmark_ServicePassing);
 
+static void Benchmark_LocalServicePassing(benchmark::State &state) {
+    auto services = di::LocalServices<A, B, C, D>{};
+    std::vector<LocalUser> vec;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(vec.emplace_back(services));
+}
+BENCHMARK(Benchmark_LocalServicePassing);
+
 static void Benchmark_DepsPassing(benchmark::State &state) {
     A a;
     B b;
@@ -128,6 +159,16 @@ static void Benchmark_SharedPtrPassing(benchmark::State &state) {
 }
 BENCHMARK(Benchmark_SharedPtrPassing);
 
+static void Benchmark_LocalPtrPassing(benchmark::State &state) {
+    auto a = di::make_local<A>();
+    auto b = di::make_local<B>();
+    auto c = di::make_local<C>();
+    std::vector<LocalPtrUser> vec;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(vec.emplace_back(a, b, c));
+}
+BENCHMARK(Benchmark_LocalPtrPassing);
+
 static void Benchmark_ServiceExtending(benchmark::State &state) {
     auto services = di::Services<A, B, C>{};
     for(auto _ : state) {
@@ -147,6 +188,81 @@ static void Benchmark_ServiceCombining(benchmark::State &state) {
 }
 BENCHMARK(Benchmark_ServiceCombining);
 
+// rvalue variants move the holders around instead of copying them;
+// narrowing the result back (also by moving) restores the inputs for the next round
+
+static void Benchmark_ServiceExtendingRvalue(benchmark::State &state) {
+    auto services = di::Services<A, B, C>{};
+    for(auto _ : state) {
+        auto extended = di::extend(std::move(services), std::make_shared<D>());
+        benchmark::DoNotOptimize(extended);
+        services = di::Services<A, B, C>{ std::move(extended) };
+    }
+}
+BENCHMARK(Benchmark_ServiceExtendingRvalue);
+
+static void Benchmark_ServiceCombiningRvalue(benchmark::State &state) {
+    auto s1 = di::Services<A, B>{};
+    auto s2 = di::Services<C, D>{};
+    for(auto _ : state) {
+        auto combined = di::combine(std::move(s1), std::move(s2));
+        benchmark::DoNotOptimize(combined);
+        s1 = di::Services<A, B>{ std::move(combined) };
+        s2 = di::Services<C, D>{ std::move(combined) };
+    }
+}
+BENCHMARK(Benchmark_ServiceCombiningRvalue);
+
+using Bundle1 = di::Services<Small<0>, Small<1>, Small<2>>;
+using Bundle2 = di::Services<Small<3>, Small<4>, Small<5>>;
+using Bundle3 = di::Services<Small<6>, Small<7>, Small<8>>;
+using Bundle4 = di::Services<Small<9>, Small<10>, Small<11>>;
+using Bundle5 = di::Services<Small<12>, Small<13>, Small<14>>;
+
+static void Benchmark_ManyServiceCombiningPairwise(benchmark::State &state) {
+    Bundle1 s1;
+    Bundle2 s2;
+    Bundle3 s3;
+    Bundle4 s4;
+    Bundle5 s5;
+    for(auto _ : state) {
+        auto combined = di::combine(di::combine(di::combine(di::combine(s1, s2), s3), s4), s5);
+        benchmark::DoNotOptimize(combined);
+    }
+}
+BENCHMARK(Benchmark_ManyServiceCombiningPairwise);
+
+static void Benchmark_ManyServiceCombining(benchmark::State &state) {
+    Bundle1 s1;
+    Bundle2 s2;
+    Bundle3 s3;
+    Bundle4 s4;
+    Bundle5 s5;
+    for(auto _ : state) {
+        auto combined = di::combine(s1, s2, s3, s4, s5);
+        benchmark::DoNotOptimize(combined);
+    }
+}
+BENCHMARK(Benchmark_ManyServiceCombining);
+
+static void Benchmark_ManyServiceCombiningRvalue(benchmark::State &state) {
+    Bundle1 s1;
+    Bundle2 s2;
+    Bundle3 s3;
+    Bundle4 s4;
+    Bundle5 s5;
+    for(auto _ : state) {
+        auto combined = di::combine(std::move(s1), std::move(s2), std::move(s3), std::move(s4), std::move(s5));
+        benchmark::DoNotOptimize(combined);
+        s1 = Bundle1{ std::move(combined) };
+        s2 = Bundle2{ std::move(combined) };
+        s3 = Bundle3{ std::move(combined) };
+        s4 = Bundle4{ std::move(combined) };
+        s5 = Bundle5{ std::move(combined) };
+    }
+}
+BENCHMARK(Benchmark_ManyServiceCombiningRvalue);
+
 static void Benchmark_DepsUsingStructuredBindings(benchmark::State &state) {
     A a;
     B b;
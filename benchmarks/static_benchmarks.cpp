@@ -0,0 +1,82 @@
+#include "types.hpp"
+#include <di.hpp>
+
+#include <benchmark/benchmark.h>
+#include <functional>
+
+// Access-heavy loops over process-wide singletons: static storage vs.
+// shared_ptr and reference holders. items/s counts service accesses.
+
+namespace {
+
+template <typename T>
+T &deref(std::reference_wrapper<T> ref) {
+    return ref.get();
+}
+
+template <typename H>
+auto &deref(H const &holder) {
+    return *holder;
+}
+
+template <typename Selection>
+struct Stepper {
+    Selection services;
+
+    int step() const {
+        deref(services.template get<A>()).value += 1;
+        auto const skip = deref(services.template get<B>()).value ? 1 : 0;
+        return deref(services.template get<A>()).value + skip + static_cast<int>(deref(services.template get<D>()).value);
+    }
+};
+
+constinit auto static_services = di::StaticServices<A, B, const D>{};
+
+} // namespace
+
+static void Benchmark_StaticServicesAccess(benchmark::State &state) {
+    Stepper<di::StaticServices<A, const B, const D>> stepper{ static_services };
+    for(auto _ : state)
+        benchmark::DoNotOptimize(stepper.step());
+    state.SetItemsProcessed(state.iterations() * 4);
+}
+BENCHMARK(Benchmark_StaticServicesAccess);
+
+static void Benchmark_ServicesAccess(benchmark::State &state) {
+    static auto services = di::Services<A, B, const D>{};
+    Stepper<di::Services<A, const B, const D>> stepper{ services };
+    for(auto _ : state)
+        benchmark::DoNotOptimize(stepper.step());
+    state.SetItemsProcessed(state.iterations() * 4);
+}
+BENCHMARK(Benchmark_ServicesAccess);
+
+static void Benchmark_DepsAccess(benchmark::State &state) {
+    static A a;
+    static B b;
+    static D const d;
+    Stepper<di::Deps<A, const B, const D>> stepper{ di::Deps<A, const B, const D>{ a, b, d } };
+    for(auto _ : state)
+        benchmark::DoNotOptimize(stepper.step());
+    state.SetItemsProcessed(state.iterations() * 4);
+}
+BENCHMARK(Benchmark_DepsAccess);
+
+static void Benchmark_StaticServicesPassing(benchmark::State &state) {
+    for(auto _ : state) {
+        Stepper<di::StaticServices<A, const B, const D>> stepper{ static_services };
+        benchmark::DoNotOptimize(stepper.step());
+    }
+    state.SetItemsProcessed(state.iterations() * 4);
+}
+BENCHMARK(Benchmark_StaticServicesPassing);
+
+static void Benchmark_ServicesPassing(benchmark::State &state) {
+    static auto services = di::Services<A, B, const D>{};
+    for(auto _ : state) {
+        Stepper<di::Services<A, const B, const D>> stepper{ services };
+        benchmark::DoNotOptimize(stepper.step());
+    }
+    state.SetItemsProcessed(state.iterations() * 4);
+}
+BENCHMARK(Benchmark_ServicesPassing);
@@ -0,0 +1,52 @@
+#include <di.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <mutex>
+
+// Producers calling a non-thread-safe service: queued on a strand vs. behind a
+// mutex; items/s counts calls.
+
+namespace {
+
+struct Machine {
+    std::uint64_t state = 0;
+
+    void step(std::uint64_t input) {
+        state = state * 31 + input;
+    }
+};
+
+struct LockedMachine {
+    std::mutex mtx;
+    Machine machine;
+
+    void step(std::uint64_t input) {
+        std::lock_guard<std::mutex> g(mtx);
+        machine.step(input);
+    }
+};
+
+} // namespace
+
+static void Benchmark_StrandService(benchmark::State &state) {
+    static auto services = di::StrandServices<Machine>{};
+    auto holder          = services.get<Machine>();
+
+    std::uint64_t i = 0;
+    for(auto _ : state)
+        holder.post([input = i++](Machine &m) { m.step(input); });
+    state.SetItemsProcessed(static_cast<std::int64_t>(i));
+}
+BENCHMARK(Benchmark_StrandService)->ThreadRange(1, 64)->UseRealTime();
+
+static void Benchmark_MutexGuardedService(benchmark::State &state) {
+    static auto services = di::Services<LockedMachine>{};
+    auto holder          = services.get<LockedMachine>();
+
+    std::uint64_t i = 0;
+    for(auto _ : state)
+        holder->step(i++);
+    state.SetItemsProcessed(static_cast<std::int64_t>(i));
+}
+BENCHMARK(Benchmark_MutexGuardedService)->ThreadRange(1, 64)->UseRealTime();
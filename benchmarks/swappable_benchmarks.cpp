@@ -0,0 +1,83 @@
+#include <di.hpp>
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <mutex>
+
+// Read throughput while thread 0 keeps publishing new instances; items/s
+// counts the reads of the other threads only.
+
+namespace {
+
+struct Table {
+    int entries[16] = {};
+};
+
+int lookup(Table const &table, std::int64_t i) {
+    return table.entries[i & 15];
+}
+
+struct MutexSwappable {
+    std::mutex mtx;
+    std::shared_ptr<Table const> current = std::make_shared<Table>();
+
+    std::shared_ptr<Table const> read() {
+        std::lock_guard<std::mutex> g(mtx);
+        return current;
+    }
+
+    void publish(std::shared_ptr<Table const> table) {
+        std::lock_guard<std::mutex> g(mtx);
+        current = std::move(table);
+    }
+};
+
+struct AtomicSharedSwappable {
+    std::atomic<std::shared_ptr<Table const>> current = std::make_shared<Table const>();
+};
+
+} // namespace
+
+static void Benchmark_SwappableReads(benchmark::State &state) {
+    static auto services = di::SwappableServices<const Table>{};
+    auto holder          = services.get<Table>();
+
+    std::int64_t i = 0;
+    for(auto _ : state) {
+        if(state.thread_index() == 0)
+            holder.publish(Table{});
+        else
+            benchmark::DoNotOptimize(lookup(*holder.read(), i++));
+    }
+    state.SetItemsProcessed(i);
+}
+BENCHMARK(Benchmark_SwappableReads)->ThreadRange(2, 64)->UseRealTime();
+
+static void Benchmark_MutexSharedPtrReads(benchmark::State &state) {
+    static MutexSwappable swappable;
+
+    std::int64_t i = 0;
+    for(auto _ : state) {
+        if(state.thread_index() == 0)
+            swappable.publish(std::make_shared<Table const>());
+        else
+            benchmark::DoNotOptimize(lookup(*swappable.read(), i++));
+    }
+    state.SetItemsProcessed(i);
+}
+BENCHMARK(Benchmark_MutexSharedPtrReads)->ThreadRange(2, 64)->UseRealTime();
+
+static void Benchmark_AtomicSharedPtrReads(benchmark::State &state) {
+    static AtomicSharedSwappable swappable;
+
+    std::int64_t i = 0;
+    for(auto _ : state) {
+        if(state.thread_index() == 0)
+            swappable.current.store(std::make_shared<Table const>());
+        else
+            benchmark::DoNotOptimize(lookup(*swappable.current.load(), i++));
+    }
+    state.SetItemsProcessed(i);
+}
+BENCHMARK(Benchmark_AtomicSharedPtrReads)->ThreadRange(2, 64)->UseRealTime();
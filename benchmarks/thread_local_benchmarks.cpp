@@ -0,0 +1,51 @@
+#include "threading.hpp"
+#include <di.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <mutex>
+
+namespace {
+
+struct Accumulator {
+    std::uint64_t count = 0;
+    std::uint64_t sum   = 0;
+
+    void add(std::uint64_t value) {
+        ++count;
+        sum += value;
+    }
+};
+
+struct LockedAccumulator {
+    std::mutex mtx;
+    Accumulator accumulator;
+
+    void add(std::uint64_t value) {
+        std::lock_guard<std::mutex> g(mtx);
+        accumulator.add(value);
+    }
+};
+
+} // namespace
+
+static void Benchmark_MutexSharedService(benchmark::State &state) {
+    static auto services = di::Services<LockedAccumulator>{};
+    auto holder          = services.get<LockedAccumulator>();
+
+    std::uint64_t i = 0;
+    for(auto _ : state)
+        holder->add(i++);
+}
+BENCHMARK(Benchmark_MutexSharedService)->ThreadRange(1, 64)->UseRealTime();
+
+static void Benchmark_ThreadLocalService(benchmark::State &state) {
+    static auto services = di::ThreadLocalServices<Accumulator>{ [] { return Accumulator{}; } };
+    auto holder          = services.get<Accumulator>();
+
+    std::uint64_t i = 0;
+    for(auto _ : state)
+        holder->add(i++);
+    benchmark::DoNotOptimize(holder->sum);
+}
+BENCHMARK(Benchmark_ThreadLocalService)->ThreadRange(1, 64)->UseRealTime();
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <algorithm>
+#include <thread>
+
+/**
+ * @brief Upper bound for multi-threaded benchmark ranges
+ */
+inline int max_threads() {
+    return static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
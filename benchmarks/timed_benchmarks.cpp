@@ -0,0 +1,44 @@
+#include <di.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+namespace {
+
+struct Counter {
+    std::uint64_t hits = 0;
+
+    void hit() {
+        ++hits;
+    }
+};
+
+} // namespace
+
+// overhead of TimedHolder per member call: compare against the plain Services
+// call; range(0) is the sampling interval (0 = timing disabled)
+
+static void Benchmark_UntimedServiceCall(benchmark::State &state) {
+    auto services = di::Services<Counter>{};
+    auto counter  = services.get<Counter>();
+    for(auto _ : state) {
+        counter->hit();
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(Benchmark_UntimedServiceCall);
+
+static void Benchmark_TimedServiceCall(benchmark::State &state) {
+    auto const previous = di::latency_sampling();
+    di::set_latency_sampling(static_cast<std::uint32_t>(state.range(0)));
+
+    auto services = di::TimedServices<Counter>{};
+    auto counter  = services.get<Counter>();
+    for(auto _ : state) {
+        counter->hit();
+        benchmark::ClobberMemory();
+    }
+
+    di::set_latency_sampling(previous);
+}
+BENCHMARK(Benchmark_TimedServiceCall)->Arg(0)->Arg(1)->Arg(16)->Arg(256)->Arg(4096);
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+struct A {
+    int value = 1234;
+};
+
+struct B {
+    bool value = false;
+};
+
+struct C {
+    std::string value = "Unchanged";
+};
+
+struct D {
+    float value = 0.42f;
+};
+
+/**
+ * @brief Small distinct service type to build large selections from
+ */
+template <std::size_t N>
+struct Small {
+    std::size_t value = N;
+};
+
+template <template <typename...> typename Sel, typename Seq>
+struct many_small;
+
+template <template <typename...> typename Sel, std::size_t... Is>
+struct many_small<Sel, std::index_sequence<Is...>> {
+    using type = Sel<Small<Is>...>;
+};
+
+/**
+ * @brief Selection of N distinct Small services
+ */
+template <template <typename...> typename Sel, std::size_t N>
+using many_small_t = typename many_small<Sel, std::make_index_sequence<N>>::type;
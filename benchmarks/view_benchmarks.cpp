@@ -0,0 +1,58 @@
+#include "threading.hpp"
+#include "types.hpp"
+#include <di.hpp>
+
+#include <benchmark/benchmark.h>
+
+struct ServicesHolderUser {
+    using services_t = di::Services<A, B, const C>;
+    ServicesHolderUser(services_t services)
+        : services_{ services } {}
+    services_t services_;
+};
+
+struct ViewUser {
+    using services_t = di::SelectionView<A, B, const C>;
+    ViewUser(services_t services)
+        : services_{ services } {}
+    services_t services_;
+};
+
+static void Benchmark_ServicePassingThreaded(benchmark::State &state) {
+    static auto services = di::Services<A, B, C, D>{};
+    for(auto _ : state) {
+        ServicesHolderUser user{ services };
+        benchmark::DoNotOptimize(user);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Benchmark_ServicePassingThreaded)->ThreadRange(1, max_threads())->UseRealTime();
+
+static void Benchmark_SelectionViewPassingThreaded(benchmark::State &state) {
+    static auto services = di::Services<A, B, C, D>{};
+    for(auto _ : state) {
+        ViewUser user{ services };
+        benchmark::DoNotOptimize(user);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Benchmark_SelectionViewPassingThreaded)->ThreadRange(1, max_threads())->UseRealTime();
+
+static void Benchmark_SelectionViewRepassingThreaded(benchmark::State &state) {
+    static auto services = di::Services<A, B, C, D>{};
+    auto view            = di::SelectionView<A, B, C, D>{ services };
+    for(auto _ : state) {
+        ViewUser user{ view };
+        benchmark::DoNotOptimize(user);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Benchmark_SelectionViewRepassingThreaded)->ThreadRange(1, max_threads())->UseRealTime();
+
+static void Benchmark_SelectionViewGet(benchmark::State &state) {
+    auto services = di::Services<A, B, C, D>{};
+    auto view     = di::SelectionView<A, B, C, D>{ services };
+    for(auto _ : state)
+        benchmark::DoNotOptimize(view.get<A>()->value);
+}
+BENCHMARK(Benchmark_SelectionViewGet);
@@ -0,0 +1,39 @@
+#include "services.hpp"
+
+#include <iostream>
+#include <string>
+
+// Writes the construction timeline of the LogService/NetworkService/Watchdog
+// graph as a Chrome trace; open it in chrome://tracing or ui.perfetto.dev.
+int main(int argc, char **argv) {
+    auto const path = std::string{ argc > 1 ? argv[1] : "startup_trace.json" };
+
+    TraceRecorder recorder;
+    {
+        ScopedTrace tracing{ recorder };
+
+        // eager default construction
+        auto logs = Services<LogService>{};
+
+        // auto-wiring, sequentially and level by level on a pool
+        auto graph = Injector<Watchdog>::build();
+        ThreadPool pool{ 2 };
+        auto parallel_graph = Injector<Watchdog>::build(pool);
+
+        // a lazy factory resolving another lazy service shows as its parent
+        auto lazy_logs    = LazyServices<LogService>{ [] { return LogService{}; } };
+        auto lazy_network = LazyServices<NetworkService>{ [lazy_logs] {
+            return NetworkService{ Services<LogService>{ *lazy_logs.get<LogService>() } };
+        } };
+        lazy_network.get<NetworkService>()->send("traced");
+
+        graph.get<Watchdog>()->test();
+    }
+
+    if(not recorder.save(path)) {
+        std::cerr << "Could not write " << path << '\n';
+        return 1;
+    }
+    std::cout << "Wrote " << recorder.events().size() << " events to " << path << '\n';
+    return 0;
+}
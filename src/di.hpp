@@ -1,10 +1,30 @@
 #pragma once
 
+#include <di/async_lazy.hpp>
 #include <di/combinators.hpp>
+#include <di/executor.hpp>
 #include <di/extensions.hpp>
+#include <di/injector.hpp>
 #include <di/lazy.hpp>
+#include <di/lazy_stats.hpp>
+#include <di/local.hpp>
+#include <di/pooled.hpp>
+#include <di/replicated.hpp>
+#include <di/scope.hpp>
 #include <di/selection.hpp>
+#include <di/seqlock.hpp>
+#include <di/static.hpp>
+#include <di/strand.hpp>
+#include <di/swappable.hpp>
+#include <di/task.hpp>
+#include <di/thread_local.hpp>
+#include <di/thread_slot.hpp>
+#include <di/timed.hpp>
+#include <di/trace.hpp>
+#include <di/trace_hook.hpp>
 #include <di/util.hpp>
+#include <di/view.hpp>
+#include <di/warm_up.hpp>
 
 namespace di {
 
@@ -14,7 +34,40 @@ using Services = Selection<std::shared_ptr, Types...>;
 template <typename... Types>
 using Deps = Selection<std::reference_wrapper, Types...>;
 
+template <typename... Types>
+using LocalServices = Selection<LocalPtr, Types...>;
+
 template <typename... Types>
 using LazyServices = Selection<LazyHolder, Types...>;
 
+template <typename... Types>
+using AsyncLazyServices = Selection<AsyncLazyHolder, Types...>;
+
+template <typename... Types>
+using PooledServices = Selection<PooledHolder, Types...>;
+
+template <typename... Types>
+using ReplicatedServices = Selection<ReplicatedHolder, Types...>;
+
+template <typename... Types>
+using SeqLockServices = Selection<SeqLockHolder, Types...>;
+
+template <typename... Types>
+using StaticServices = Selection<StaticHolder, Types...>;
+
+template <typename... Types>
+using StrandServices = Selection<StrandHolder, Types...>;
+
+template <typename... Types>
+using SwappableServices = Selection<SwappableHolder, Types...>;
+
+template <typename... Types>
+using ThreadLocalServices = Selection<ThreadLocalHolder, Types...>;
+
+template <typename... Types>
+using TimedServices = Selection<TimedHolder, Types...>;
+
+template <typename... Types>
+using SelectionView = Selection<ViewHolder, Types...>;
+
 } // namespace di
\ No newline at end of file
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <di/selection.hpp>
+#include <di/task.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace di {
+
+/**
+ * @brief The type an awaitable produces when awaited
+ * 
+ * @tparam A The awaitable
+ */
+template <typename A>
+struct await_result {
+    using type = decltype(std::declval<A>().await_resume());
+};
+
+template <typename A>
+requires requires { std::declval<A>().operator co_await(); }
+struct await_result<A> {
+    using type = decltype(std::declval<A>().operator co_await().await_resume());
+};
+
+template <typename A>
+using await_result_t = typename await_result<A>::type;
+
+/**
+ * @brief A requirement for Fn to produce an awaitable of a shared instance of T or of T by value
+ * 
+ * @tparam Fn
+ * @tparam T
+ */
+template <typename Fn, typename T>
+concept AsyncFactoryFor = std::is_invocable_v<Fn &>
+    and (std::is_convertible_v<await_result_t<std::invoke_result_t<Fn &>>, std::shared_ptr<T>>
+        or std::is_same_v<await_result_t<std::invoke_result_t<Fn &>>, std::remove_const_t<T>>);
+
+namespace detail {
+
+/**
+ * @brief State shared by all copies of an AsyncLazyHolder (and its const promotions).
+ * 
+ * Coroutines awaiting the instance while it is being created are queued
+ * and resumed by whichever thread finishes the factory.
+ * 
+ * @tparam V The non-const service type
+ */
+template <typename V>
+struct async_lazy_state {
+    struct waiter {
+        std::coroutine_handle<> handle;
+        waiter *next = nullptr;
+        std::exception_ptr error;
+    };
+
+    std::atomic<bool> ready = false; /*! Published once instance is set */
+    std::mutex mtx;                  /*! Guards waiters and running, never held while suspended */
+    waiter *waiters = nullptr;
+    bool running    = false;
+    std::shared_ptr<V> instance;
+
+    virtual ~async_lazy_state() = default;
+
+    /**
+     * @brief Starts the factory; it must eventually call complete() or fail()
+     */
+    virtual void start(std::shared_ptr<async_lazy_state> self) = 0;
+
+    /**
+     * @brief Enqueue a waiter, starting the factory if nobody did yet
+     * 
+     * @return false if the instance is already there and the waiter should not suspend
+     */
+    static bool enqueue(std::shared_ptr<async_lazy_state> self, waiter &w) {
+        auto start = false;
+        {
+            std::lock_guard<std::mutex> g(self->mtx);
+            if(self->ready.load(std::memory_order_relaxed))
+                return false;
+
+            w.next        = self->waiters;
+            self->waiters = &w;
+            start         = not std::exchange(self->running, true);
+        }
+
+        // w may already be resumed (and gone) once the factory completes
+        if(start)
+            self->start(self);
+        return true;
+    }
+
+    void complete(std::shared_ptr<V> result) {
+        auto list = [&] {
+            std::lock_guard<std::mutex> g(mtx);
+            instance = std::move(result);
+            ready.store(true, std::memory_order_release);
+            running = false;
+            return std::exchange(waiters, nullptr);
+        }();
+        resume(list, nullptr);
+    }
+
+    void fail(std::exception_ptr error) {
+        auto list = [&] {
+            std::lock_guard<std::mutex> g(mtx);
+            running = false; // the next awaiter retries
+            return std::exchange(waiters, nullptr);
+        }();
+        resume(list, error);
+    }
+
+private:
+    static void resume(waiter *list, std::exception_ptr error) {
+        while(list) {
+            auto next   = list->next;
+            list->error = error;
+            list->handle.resume();
+            list = next;
+        }
+    }
+};
+
+template <typename V>
+struct ready_async_lazy_state : async_lazy_state<V> {
+    void start(std::shared_ptr<async_lazy_state<V>>) override {}
+};
+
+/**
+ * @brief Async lazy state storing the factory by its concrete type
+ * 
+ * @tparam V The non-const service type
+ * @tparam Fn The factory type
+ */
+template <typename V, typename Fn>
+struct factory_async_lazy_state : async_lazy_state<V> {
+    using result_t = await_result_t<std::invoke_result_t<Fn &>>;
+    Fn factory;
+
+    explicit factory_async_lazy_state(Fn fn)
+        : factory{ std::move(fn) } {}
+
+    void start(std::shared_ptr<async_lazy_state<V>> self) override {
+        drive(std::move(self), this);
+    }
+
+private:
+    // keep_alive lives in the coroutine frame, keeping the state alive until the factory finishes
+    static detached drive([[maybe_unused]] std::shared_ptr<async_lazy_state<V>> keep_alive, factory_async_lazy_state *self) {
+        std::optional<std::shared_ptr<V>> instance;
+        try {
+            if constexpr(std::is_same_v<result_t, V>)
+                instance = std::make_shared<V>(co_await self->factory());
+            else
+                instance = std::const_pointer_cast<V>(std::shared_ptr<V const>(co_await self->factory()));
+        } catch(...) {
+            self->fail(std::current_exception());
+        }
+        if(instance)
+            self->complete(std::move(*instance));
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief A Selection holder type that lazily creates its instance with an asynchronous factory.
+ * 
+ * The factory returns an awaitable (e.g. a @ref Task) producing either a
+ * `std::shared_ptr<T>` or T by value. Awaiting the holder runs the factory
+ * on first use; concurrent awaiters are suspended and resumed once the single
+ * in-flight construction finishes, so no thread is ever blocked waiting:
+ * @code
+ *   auto db = co_await services.get<Database>(); // std::shared_ptr<Database>
+ * @endcode
+ * 
+ * Awaiters are resumed on the thread that completes the factory. If the
+ * factory throws, every waiter receives the exception and the next await
+ * retries.
+ * 
+ * An AsyncLazyHolder<T> converts to an AsyncLazyHolder<const T> sharing the same state.
+ * 
+ * @tparam T
+ */
+template <typename T>
+class AsyncLazyHolder {
+    using value_t = std::remove_const_t<T>;
+    using ptr_t   = std::shared_ptr<T>;
+    using state_t = detail::async_lazy_state<value_t>;
+    using data_t  = std::shared_ptr<state_t>;
+
+    data_t data_;
+
+    template <typename>
+    friend class AsyncLazyHolder;
+
+public:
+    /**
+     * @brief Store an asynchronous factory for lazy loading.
+     * 
+     * @tparam Fn Any compatible function or lambda
+     * @param factory Expected to return an awaitable of `shared_ptr<T>` or T
+     */
+    template <typename Fn>
+    AsyncLazyHolder(Fn factory) requires AsyncFactoryFor<Fn, T>
+        : data_{ std::make_shared<detail::factory_async_lazy_state<value_t, Fn>>(std::move(factory)) } {
+    }
+
+    /**
+     * @brief Store an instance eagerly.
+     * 
+     * @param ptr The instance
+     */
+    AsyncLazyHolder(ptr_t ptr) {
+        auto state      = std::make_shared<detail::ready_async_lazy_state<value_t>>();
+        state->instance = std::const_pointer_cast<value_t>(ptr);
+        state->ready.store(true, std::memory_order_release);
+        data_ = std::move(state);
+    }
+
+    /**
+     * @brief Promote a holder of non-const T to a holder of const T.
+     * 
+     * @param other The holder to share state with
+     */
+    template <typename U>
+    AsyncLazyHolder(AsyncLazyHolder<U> const &other) requires std::is_same_v<T, U const>
+        : data_{ other.data_ } {
+    }
+
+    /**
+     * @brief Check whether the instance was already created (without creating it).
+     * 
+     * @return true if awaiting will not suspend
+     */
+    bool loaded() const noexcept {
+        return data_->ready.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Await the instance, starting the factory if needed.
+     * 
+     * @return Awaitable producing ptr_t
+     */
+    auto operator co_await() const noexcept {
+        struct awaiter : state_t::waiter {
+            data_t data;
+
+            bool await_ready() const noexcept {
+                return data->ready.load(std::memory_order_acquire);
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle) {
+                this->handle = handle;
+                return state_t::enqueue(data, *this);
+            }
+
+            ptr_t await_resume() const {
+                if(this->error)
+                    std::rethrow_exception(this->error);
+                return data->instance;
+            }
+        };
+        return awaiter{ {}, data_ };
+    }
+};
+
+} // namespace di
@@ -2,6 +2,9 @@
 
 #include <di/selection.hpp>
 
+#include <type_traits>
+#include <utility>
+
 namespace di {
 
 /**
@@ -21,46 +24,106 @@ constexpr Selection<HType, SenderTypes..., OtherTypes...> extend(
         "Additional types should not match any types from extended service");
     return Selection<HType, SenderTypes..., OtherTypes...>{
         selection.template get<SenderTypes>()...,
-        others...
+        std::move(others)...
     };
 }
 
 /**
- * @brief Allows to combine two selections into one
+ * @brief Extends an expiring selection, moving its holders instead of copying them
  * 
- * @tparam LTypes Left selection types
- * @tparam RTypes Right selection types
- * @param lhs Left selection
- * @param rhs Right selection
- * @return constexpr Selection<LTypes..., RTypes...> Combined selection
+ * @tparam SenderTypes Types of selection being extended
+ * @tparam OtherTypes Types to add to the selection
+ * @param Selection The selection being extended
+ * @param others Objects to add to the selection
+ * @return constexpr Selection<SenderTypes..., OtherTypes...> Extended selection
  */
-template <template <typename> typename HType, typename... LTypes, typename... RTypes>
-constexpr Selection<HType, LTypes..., RTypes...> combine(
-    Selection<HType, LTypes...> const &lhs,
-    Selection<HType, RTypes...> const &rhs) {
-    return Selection<HType, LTypes..., RTypes...>{
-        lhs.template get<LTypes>()...,
-        rhs.template get<RTypes>()...
+template <template <typename> typename HType, typename... SenderTypes, typename... OtherTypes>
+constexpr Selection<HType, SenderTypes..., OtherTypes...> extend(
+    Selection<HType, SenderTypes...> &&selection,
+    HType<OtherTypes>... others) {
+    static_assert((not any_type_match<SenderTypes, OtherTypes...>::value && ...),
+        "Additional types should not match any types from extended service");
+    return Selection<HType, SenderTypes..., OtherTypes...>{
+        std::move(selection).template get<SenderTypes>()...,
+        std::move(others)...
     };
 }
 
+namespace detail {
+
 /**
- * @brief Allows to combine multiple selections into one
+ * @brief Concatenates the types of selections sharing one holder type
+ */
+template <template <typename> typename HType, typename List, typename... Selections>
+struct combined_selection;
+
+template <template <typename> typename HType, typename... Types>
+struct combined_selection<HType, type_list<Types...>> {
+    using type = Selection<HType, Types...>;
+};
+
+template <template <typename> typename HType, typename... Types, typename... Next, typename... Rest>
+struct combined_selection<HType, type_list<Types...>, Selection<HType, Next...>, Rest...>
+    : combined_selection<HType, type_list<Types..., Next...>, Rest...> {};
+
+template <typename First, typename... Rest>
+struct combined;
+
+template <template <typename> typename HType, typename... Types, typename... Rest>
+struct combined<Selection<HType, Types...>, Rest...>
+    : combined_selection<HType, type_list<Types...>, Rest...> {};
+
+template <typename... Selections>
+using combined_t = typename combined<std::remove_cvref_t<Selections>...>::type;
+
+/**
+ * @brief Whether a selection stores T exactly as spelled (const included)
+ */
+template <typename S, typename T>
+struct stores;
+
+template <template <typename> typename HType, typename... Types, typename T>
+struct stores<Selection<HType, Types...>, T> : std::bool_constant<MappedOnce<T, type_index_map<Types...>>> {};
+
+/**
+ * @brief The holder of T, copied from (or moved out of) the selection storing it
+ */
+template <typename T, typename First, typename... Rest>
+constexpr auto pick(First &&first, Rest &&... rest) {
+    if constexpr(stores<std::remove_cvref_t<First>, T>::value)
+        return std::forward<First>(first).template get<T>();
+    else
+        return pick<T>(std::forward<Rest>(rest)...);
+}
+
+template <typename Result>
+struct combine_into;
+
+template <template <typename> typename HType, typename... Types>
+struct combine_into<Selection<HType, Types...>> {
+    template <typename... Selections>
+    static constexpr Selection<HType, Types...> from(Selections &&... selections) {
+        return Selection<HType, Types...>{ pick<Types>(std::forward<Selections>(selections)...)... };
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Allows to combine any amount of selections into one
+ * 
+ * All selections are combined in a single pass: each holder is copied once
+ * (or moved out of expiring selections) into the result, without building
+ * intermediate selections.
  * 
- * @tparam LType Leftmost selection types
- * @tparam MType Next selection types
- * @tparam Others All other selections
- * @param lhs Leftmost selection
- * @param mid Next selection
- * @param others All other selections
- * @return decltype(auto) Combined selection
+ * @tparam Selections Selections sharing one holder type (required to have no types in common)
+ * @param selections The selections to combine, in order
+ * @return constexpr auto Selection<HType, Types of all selections...>
  */
-template <typename LType, typename MType, typename... Others>
-constexpr auto combine(
-    LType const &lhs,
-    MType const &mid,
-    Others const &... others) -> decltype(auto) {
-    return combine(combine(lhs, mid), others...);
+template <typename... Selections>
+constexpr auto combine(Selections &&... selections) -> detail::combined_t<Selections...>
+requires(sizeof...(Selections) >= 2) {
+    return detail::combine_into<detail::combined_t<Selections...>>::from(std::forward<Selections>(selections)...);
 }
 
 /**
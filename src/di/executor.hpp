@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace di {
+
+/**
+ * @brief A requirement for E to run posted callables (possibly on other threads)
+ * 
+ * @tparam E
+ */
+template <typename E>
+concept Executor = requires(E &executor, std::function<void()> fn) {
+    executor.post(std::move(fn));
+};
+
+/**
+ * @brief A simple fixed-size thread pool satisfying @ref Executor
+ * 
+ * Posted callables run in FIFO order. The destructor runs everything
+ * still queued and joins the workers.
+ */
+class ThreadPool {
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> queue_;
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+
+public:
+    /**
+     * @brief Start the workers
+     * 
+     * @param threads Amount of worker threads (at least one)
+     */
+    explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency()) {
+        threads = std::max<std::size_t>(threads, 1);
+        workers_.reserve(threads);
+        for(std::size_t i = 0; i < threads; ++i)
+            workers_.emplace_back([this] { run(); });
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> g(mtx_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for(auto &worker : workers_)
+            worker.join();
+    }
+
+    ThreadPool(ThreadPool const &) = delete;
+    ThreadPool &operator=(ThreadPool const &) = delete;
+
+    /**
+     * @brief Queue a callable to be run by one of the workers
+     * 
+     * @param fn The callable
+     */
+    void post(std::function<void()> fn) {
+        {
+            std::lock_guard<std::mutex> g(mtx_);
+            queue_.push_back(std::move(fn));
+        }
+        cv_.notify_one();
+    }
+
+    std::size_t size() const noexcept {
+        return workers_.size();
+    }
+
+private:
+    void run() {
+        while(true) {
+            std::function<void()> fn;
+            {
+                std::unique_lock<std::mutex> lock(mtx_);
+                cv_.wait(lock, [this] { return stopping_ or not queue_.empty(); });
+                if(queue_.empty())
+                    return; // stopping and drained
+                fn = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            fn();
+        }
+    }
+};
+
+} // namespace di
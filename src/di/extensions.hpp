@@ -2,6 +2,8 @@
 
 #include <di/selection.hpp>
 
+#include <utility>
+
 namespace di {
 
 /**
@@ -12,8 +14,8 @@ namespace di {
  * @return decltype(auto) The resulting selection as tuple or single wrapped object
  */
 template <typename... Ts>
-constexpr decltype(auto) get(auto const &selection) {
-    return selection.template get<Ts...>();
+constexpr decltype(auto) get(auto &&selection) {
+    return std::forward<decltype(selection)>(selection).template get<Ts...>();
 }
 
 } // namespace di
\ No newline at end of file
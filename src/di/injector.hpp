@@ -0,0 +1,259 @@
+#pragma once
+
+#include <di/executor.hpp>
+#include <di/selection.hpp>
+#include <di/util.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace di {
+
+/**
+ * @brief A requirement for T to declare its dependencies via a nested `services_t` selection
+ * 
+ * @tparam T
+ */
+template <typename T>
+concept DeclaresServices = requires {
+    typename T::services_t;
+};
+
+/**
+ * @brief The (non-const) service types a type T depends on
+ * 
+ * Types without a nested `services_t` have no dependencies.
+ * 
+ * @tparam T
+ */
+template <typename T>
+struct dependencies_of {
+    using type = type_list<>;
+};
+
+template <DeclaresServices T>
+struct dependencies_of<T> : dependencies_of<typename T::services_t> {};
+
+template <template <typename> typename HolderType, typename... Types>
+struct dependencies_of<Selection<HolderType, Types...>> {
+    using type = type_list<std::remove_const_t<Types>...>;
+};
+
+template <typename T>
+using dependencies_of_t = typename dependencies_of<T>::type;
+
+namespace detail {
+
+template <typename Order, typename Path, typename List>
+struct visit_all;
+
+/**
+ * @brief Depth-first visit of T appending it to Order after all of its dependencies
+ * 
+ * @tparam Order Types already placed in construction order
+ * @tparam Path Types currently being visited (used to detect cycles)
+ * @tparam T The type to visit
+ */
+template <typename Order, typename Path, typename T,
+    bool Placed = list_contains<T, Order>::value,
+    bool Cycle  = list_contains<T, Path>::value>
+struct visit {
+    using type = Order;
+};
+
+template <typename Order, typename Path, typename T>
+struct visit<Order, Path, T, false, true> {
+    static_assert(always_false<T>, "Dependency cycle detected: T (transitively) depends on itself");
+    using type = Order;
+};
+
+template <typename Order, typename Path, typename T>
+struct visit<Order, Path, T, false, false> {
+    using with_deps = typename visit_all<Order, typename list_append<Path, T>::type, dependencies_of_t<T>>::type;
+    using type      = typename list_append<with_deps, T>::type;
+};
+
+template <typename Order, typename Path>
+struct visit_all<Order, Path, type_list<>> {
+    using type = Order;
+};
+
+template <typename Order, typename Path, typename T, typename... Rest>
+struct visit_all<Order, Path, type_list<T, Rest...>> {
+    using type = typename visit_all<typename visit<Order, Path, T>::type, Path, type_list<Rest...>>::type;
+};
+
+template <typename List>
+struct injected_services;
+
+template <typename List>
+struct level_after;
+
+template <typename T>
+struct construction_level {
+    static constexpr std::size_t value = level_after<dependencies_of_t<T>>::value;
+};
+
+template <typename... Deps>
+struct level_after<type_list<Deps...>> {
+    static constexpr std::size_t value = std::max({ std::size_t{ 0 }, (construction_level<Deps>::value + 1)... });
+};
+
+template <typename... Types>
+struct injected_services<type_list<Types...>> {
+    using type = Selection<std::shared_ptr, Types...>;
+};
+
+} // namespace detail
+
+/**
+ * @brief Construction order of Roots and everything they (transitively) depend on
+ * 
+ * Dependencies always come before their dependents.
+ * 
+ * @tparam Roots
+ */
+template <typename... Roots>
+using construction_order_t = typename detail::visit_all<type_list<>, type_list<>, type_list<std::remove_const_t<Roots>...>>::type;
+
+/**
+ * @brief Level of T in its dependency graph
+ * 
+ * Services without dependencies are on level 0, every other service is
+ * one level above its highest dependency. Services on the same level 
+ * never depend on each other.
+ * 
+ * @tparam T
+ */
+template <typename T>
+inline constexpr std::size_t construction_level_v = detail::construction_level<std::remove_const_t<T>>::value;
+
+/**
+ * @brief Compile-time auto-wiring of a service graph
+ * 
+ * Reads the `services_t` of each root and, transitively, of each dependency,
+ * computes the construction order at compile time and constructs each
+ * service exactly once. Types declaring `services_t` (a Services or a
+ * SelectionView) are constructed from it, all other types are default-constructed.
+ * 
+ * @code
+ *   auto services = Injector<Watchdog>::build(); // Services<LogService, NetworkService, Watchdog>
+ * @endcode
+ * 
+ * @tparam Roots The services to build (along with their dependencies)
+ */
+template <typename... Roots>
+class Injector {
+public:
+    using order_t    = construction_order_t<Roots...>;
+    using services_t = typename detail::injected_services<order_t>::type;
+
+    /**
+     * @brief Construct the whole graph
+     * 
+     * @return services_t Every constructed service
+     */
+    static services_t build() {
+        auto span = TraceSpan{ "Injector::build", "injector" };
+        return build(order_t{});
+    }
+
+    /**
+     * @brief Construct the whole graph level by level on an executor
+     * 
+     * All services of one level are posted to the executor at once and
+     * constructed concurrently; the next level starts once the whole level 
+     * is ready, so each service starts after its dependencies are constructed.
+     * Blocks the calling thread, which therefore must not be one the executor 
+     * relies on. If any constructor throws, the first exception is rethrown 
+     * once its level has finished.
+     * 
+     * @param executor Runs the constructors, e.g. a @ref ThreadPool
+     * @return services_t Every constructed service
+     */
+    template <Executor E>
+    static services_t build(E &executor) {
+        auto span = TraceSpan{ "Injector::build", "injector" };
+        return build(executor, order_t{});
+    }
+
+    /**
+     * @brief Construct a single service from already constructed dependencies
+     * 
+     * @tparam T The service to construct
+     * @param built Holds (at least) every dependency of T
+     * @return std::shared_ptr<T>
+     */
+    template <typename T, typename... Built>
+    static std::shared_ptr<T> construct(std::tuple<std::shared_ptr<Built>...> const &built) {
+        auto span = detail::trace_construction<T>("injector");
+        if constexpr(DeclaresServices<T>) {
+            // an lvalue, so views can borrow from it (the services are owned by built)
+            auto const dependencies = select(built, dependencies_of_t<T>{});
+            static_assert(std::is_constructible_v<typename T::services_t, decltype(dependencies) const &>,
+                "Injected services_t must be a Services or a SelectionView (e.g. not Deps): dependencies are passed as Services");
+            return std::make_shared<T>(typename T::services_t{ dependencies });
+        } else {
+            return std::make_shared<T>();
+        }
+    }
+
+private:
+    template <typename... Types>
+    static services_t build(type_list<Types...>) {
+        auto built = std::tuple<std::shared_ptr<Types>...>{};
+        ((std::get<std::shared_ptr<Types>>(built) = construct<Types>(built)), ...);
+        return services_t{ std::move(std::get<std::shared_ptr<Types>>(built))... };
+    }
+
+    template <typename E, typename... Types>
+    static services_t build(E &executor, type_list<Types...>) {
+        constexpr auto levels = std::max({ std::size_t{ 0 }, (construction_level_v<Types> + 1)... });
+
+        auto built = std::tuple<std::shared_ptr<Types>...>{};
+        [&]<std::size_t... Levels>(std::index_sequence<Levels...>) {
+            (build_level<Levels>(executor, built), ...);
+        }(std::make_index_sequence<levels>{});
+        return services_t{ std::move(std::get<std::shared_ptr<Types>>(built))... };
+    }
+
+    template <std::size_t Level, typename E, typename... Types>
+    static void build_level(E &executor, std::tuple<std::shared_ptr<Types>...> &built) {
+        constexpr auto count = static_cast<std::ptrdiff_t>(((construction_level_v<Types> == Level) + ...));
+
+        std::latch done{ count };
+        std::mutex error_mtx;
+        std::exception_ptr error;
+
+        auto post = [&]<typename T>(std::type_identity<T>) {
+            executor.post([&] {
+                try {
+                    std::get<std::shared_ptr<T>>(built) = construct<T>(built);
+                } catch(...) {
+                    std::lock_guard<std::mutex> g(error_mtx);
+                    if(not error)
+                        error = std::current_exception();
+                }
+                done.count_down();
+            });
+        };
+        ((construction_level_v<Types> == Level ? post(std::type_identity<Types>{}) : void()), ...);
+
+        done.wait();
+        if(error)
+            std::rethrow_exception(error);
+    }
+
+    template <typename... Built, typename... Deps>
+    static Selection<std::shared_ptr, Deps...> select(std::tuple<std::shared_ptr<Built>...> const &built, type_list<Deps...>) {
+        return Selection<std::shared_ptr, Deps...>{ std::get<std::shared_ptr<Deps>>(built)... };
+    }
+};
+
+} // namespace di
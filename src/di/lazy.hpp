@@ -1,45 +1,154 @@
 #pragma once
 
+#include <di/lazy_stats.hpp>
 #include <di/selection.hpp>
 
+#include <atomic>
+#include <concepts>
+#include <cstddef>
 #include <mutex>
+#include <new>
+#include <optional>
 
 namespace di {
 
-template <class... Ts>
-struct overloaded : Ts... { using Ts::operator()...; };
+/**
+ * @brief A requirement for Fn to produce a shared instance of T
+ * 
+ * @tparam Fn 
+ * @tparam T 
+ */
+template <typename Fn, typename T>
+concept SharedFactoryFor = std::is_invocable_v<Fn &>
+    and std::is_convertible_v<std::invoke_result_t<Fn &>, std::shared_ptr<T>>;
+
+/**
+ * @brief A requirement for Fn to produce an instance of T by value
+ * 
+ * @tparam Fn 
+ * @tparam T 
+ */
+template <typename Fn, typename T>
+concept ValueFactoryFor = std::is_invocable_v<Fn &>
+    and std::is_same_v<std::invoke_result_t<Fn &>, std::remove_const_t<T>>;
+
+namespace detail {
+
+/**
+ * @brief State shared by all copies of a LazyHolder (and its const promotions).
+ * 
+ * Initialization is synchronized per state, so independent holders
+ * of the same type can load concurrently.
+ * 
+ * @tparam V The non-const service type
+ */
+template <typename V>
+struct lazy_state {
+    std::atomic<bool> ready = false; /*! Published once instance is set */
+    std::mutex mtx;
+    V *instance = nullptr;
+
+    virtual ~lazy_state() = default;
+    virtual void create() = 0; /*! Runs the factory and sets instance */
+};
+
+/**
+ * @brief Lazy state holding an instance that is owned elsewhere.
+ */
+template <typename V>
+struct shared_lazy_state : lazy_state<V> {
+    std::shared_ptr<V> owner;
+
+    void create() override {}
+};
+
+/**
+ * @brief Lazy state storing the factory by its concrete type.
+ * 
+ * Factories returning the service by value construct it right inside 
+ * this state, so the control block, the factory and the instance share 
+ * one allocation.
+ * 
+ * @tparam V The non-const service type
+ * @tparam Fn The factory type
+ * @tparam InPlace Whether the factory returns the service by value
+ */
+template <typename V, typename Fn, bool InPlace = std::is_same_v<std::invoke_result_t<Fn &>, V>>
+struct factory_lazy_state : shared_lazy_state<V> {
+    std::optional<Fn> factory;
+
+    explicit factory_lazy_state(Fn fn)
+        : factory{ std::move(fn) } {}
+
+    void create() override {
+        this->owner    = std::const_pointer_cast<V>(std::shared_ptr<V const>((*factory)()));
+        this->instance = this->owner.get();
+        factory.reset(); // release whatever the factory captured
+    }
+};
 
-template <class... Ts>
-overloaded(Ts...) -> overloaded<Ts...>;
+template <typename V, typename Fn>
+struct factory_lazy_state<V, Fn, true> : lazy_state<V> {
+    std::optional<Fn> factory;
+    alignas(V) std::byte storage[sizeof(V)];
+
+    explicit factory_lazy_state(Fn fn)
+        : factory{ std::move(fn) } {}
+
+    ~factory_lazy_state() override {
+        if(this->instance)
+            this->instance->~V();
+    }
+
+    void create() override {
+        this->instance = ::new(static_cast<void *>(storage)) V((*factory)());
+        factory.reset(); // release whatever the factory captured
+    }
+};
+
+} // namespace detail
 
 /**
  * @brief A simple Selection holder type that allows lazy loading. 
  * 
  * You can instantiate the holder with a factory function 
- * or an instance (std::shared_ptr<T>).
+ * or an instance (std::shared_ptr<T>). The factory may return either 
+ * a `std::shared_ptr<T>` or T by value. In the latter case the service 
+ * is constructed in the same allocation as the holder state, so resolving 
+ * it allocates nothing.
+ * 
+ * Once the instance is created, access is a single acquire load of the
+ * ready flag. Only the first construction is synchronized, and only
+ * between copies of the same holder.
+ * 
+ * A LazyHolder<T> converts to a LazyHolder<const T> sharing the same state.
+ * 
+ * Defining DI_LAZY_STATS records accesses, factory durations and waits
+ * per service type, see @ref lazy_stats.
  * 
  * @tparam T
  */
 template <typename T>
 class LazyHolder {
-    using ptr_t     = std::shared_ptr<T>;
-    using factory_t = std::function<ptr_t()>;
-    using variant_t = std::variant<ptr_t, factory_t>;
-    using data_t    = std::shared_ptr<variant_t>;
+    using value_t = std::remove_const_t<T>;
+    using ptr_t   = std::shared_ptr<T>;
+    using data_t  = std::shared_ptr<detail::lazy_state<value_t>>;
 
     data_t data_;
-    inline static std::mutex mtx_; /*! One mutex per service type */
+
+    template <typename>
+    friend class LazyHolder;
 
 public:
     /**
      * @brief Store a factory function for lazy loading.
      * 
      * @tparam Fn Any compatible function or lambda
-     * @param factory Expected to be compatible with `shared_ptr<T>()`
+     * @param factory Expected to be compatible with `shared_ptr<T>()` or `T()`
      */
     template <typename Fn>
-    LazyHolder(Fn factory)
-        : data_{ std::make_shared<variant_t>(factory) } {
+    LazyHolder(Fn factory) requires SharedFactoryFor<Fn, T> or ValueFactoryFor<Fn, T>
+        : data_{ std::make_shared<detail::factory_lazy_state<value_t, Fn>>(std::move(factory)) } {
     }
 
     /**
@@ -47,38 +156,77 @@ public:
      * 
      * @param ptr The instance
      */
-    LazyHolder(ptr_t ptr)
-        : data_{ std::make_shared<variant_t>(ptr) } {
+    LazyHolder(ptr_t ptr) {
+        auto state      = std::make_shared<detail::shared_lazy_state<value_t>>();
+        state->owner    = std::const_pointer_cast<value_t>(ptr);
+        state->instance = state->owner.get();
+        state->ready.store(true, std::memory_order_release);
+        data_ = std::move(state);
+    }
+
+    /**
+     * @brief Promote a holder of non-const T to a holder of const T.
+     * 
+     * @param other The holder to share state with
+     */
+    template <typename U>
+    LazyHolder(LazyHolder<U> const &other) requires std::is_same_v<T, U const>
+        : data_{ other.data_ } {
     }
 
     /**
      * @brief Get a shared instance possibly invoking lazy loading.
      * 
-     * @return ptr_t
+     * @return ptr_t Shares ownership with the holder state
      */
-    ptr_t get() {
-        std::lock_guard<std::mutex> g(mtx_);
-
-        // clang-format off
-        return std::visit(
-            overloaded{
-                [](ptr_t ptr) {
-                    return ptr;
-                },
-                [this](factory_t factory) mutable {
-                    return data_->template emplace<ptr_t>(factory());
-                } 
-            }, *data_);
-        // clang-format on
+    ptr_t get() const {
+        return ptr_t(data_, operator->());
     }
 
-    ptr_t operator->() {
-        return get();
+    /**
+     * @brief Access the instance without touching the reference count.
+     * 
+     * @return T* 
+     */
+    T *operator->() const {
+        detail::lazy_probe<value_t>::access();
+        if(not data_->ready.load(std::memory_order_acquire))
+            load();
+        return data_->instance;
     }
 
-    ptr_t operator*() {
+    ptr_t operator*() const {
         return get();
     }
+
+    /**
+     * @brief Check whether the instance was already created (without creating it).
+     * 
+     * @return true if access will not invoke the factory
+     */
+    bool loaded() const noexcept {
+        return data_->ready.load(std::memory_order_acquire);
+    }
+
+private:
+    void load() const {
+        detail::lazy_probe<value_t> probe;
+        std::lock_guard<std::mutex> g(data_->mtx);
+        probe.locked();
+
+        // another thread may have finished loading while we were waiting
+        if(data_->ready.load(std::memory_order_relaxed)) {
+            probe.waited();
+            return;
+        }
+
+        {
+            auto span = detail::trace_construction<value_t>("lazy");
+            data_->create();
+        }
+        probe.created();
+        data_->ready.store(true, std::memory_order_release);
+    }
 };
 
 }; // namespace di
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <di/util.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Instrumentation of LazyHolder is compiled in only when DI_LAZY_STATS is
+// defined (e.g. with the ENABLE_LAZY_STATS CMake option). Define it for the
+// whole program: a LazyHolder<T> must not be used both with and without it.
+
+namespace di {
+
+/**
+ * @brief Statistics of the lazily created services of one type
+ */
+struct LazyStats {
+    std::string type;            /*! Name of the service type */
+    std::uint64_t accesses   = 0; /*! Calls to operator->, get() and operator* */
+    std::uint64_t creations  = 0; /*! Factory runs */
+    std::uint64_t factory_ns = 0; /*! Total time spent in the factory */
+    std::uint64_t waiters    = 0; /*! Callers that waited for another thread's initialization */
+    std::uint64_t wait_ns    = 0; /*! Total time those callers waited */
+};
+
+namespace detail {
+
+struct lazy_counters {
+    std::string type;
+    std::atomic<std::uint64_t> accesses   = 0;
+    std::atomic<std::uint64_t> creations  = 0;
+    std::atomic<std::uint64_t> factory_ns = 0;
+    std::atomic<std::uint64_t> waiters    = 0;
+    std::atomic<std::uint64_t> wait_ns    = 0;
+
+    explicit lazy_counters(std::string_view name)
+        : type{ name } {}
+};
+
+/**
+ * @brief All counters ever registered, one per service type
+ */
+class lazy_stats_registry {
+    std::mutex mtx_;
+    std::deque<lazy_counters> counters_; // stable addresses
+
+public:
+    static lazy_stats_registry &instance() {
+        static lazy_stats_registry registry;
+        return registry;
+    }
+
+    lazy_counters &add(std::string_view type) {
+        std::lock_guard<std::mutex> g(mtx_);
+        return counters_.emplace_back(type);
+    }
+
+    template <typename Fn>
+    void for_each(Fn &&fn) {
+        std::lock_guard<std::mutex> g(mtx_);
+        for(auto &c : counters_)
+            fn(c);
+    }
+};
+
+template <typename V>
+lazy_counters &lazy_counters_for() {
+    static lazy_counters &counters = lazy_stats_registry::instance().add(type_name<V>());
+    return counters;
+}
+
+#if defined(DI_LAZY_STATS)
+
+/**
+ * @brief Records the accesses and the initialization of a LazyHolder<V>
+ */
+template <typename V>
+class lazy_probe {
+    using clock = std::chrono::steady_clock;
+
+    clock::time_point requested_ = clock::now();
+    clock::time_point locked_;
+
+    static std::uint64_t since(clock::time_point start) noexcept {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+    }
+
+public:
+    static void access() noexcept {
+        lazy_counters_for<V>().accesses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void locked() noexcept {
+        locked_ = clock::now();
+    }
+
+    void waited() noexcept {
+        auto &counters = lazy_counters_for<V>();
+        counters.waiters.fetch_add(1, std::memory_order_relaxed);
+        counters.wait_ns.fetch_add(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(locked_ - requested_).count()), std::memory_order_relaxed);
+    }
+
+    void created() noexcept {
+        auto &counters = lazy_counters_for<V>();
+        counters.creations.fetch_add(1, std::memory_order_relaxed);
+        counters.factory_ns.fetch_add(since(locked_), std::memory_order_relaxed);
+    }
+};
+
+#else
+
+/**
+ * @brief Disabled instrumentation: empty and compiled to nothing
+ */
+template <typename V>
+struct lazy_probe {
+    static void access() noexcept {}
+    void locked() noexcept {}
+    void waited() noexcept {}
+    void created() noexcept {}
+};
+
+#endif
+
+} // namespace detail
+
+/**
+ * @brief Whether LazyHolder instrumentation is compiled in (DI_LAZY_STATS)
+ */
+inline constexpr bool lazy_stats_enabled =
+#if defined(DI_LAZY_STATS)
+    true;
+#else
+    false;
+#endif
+
+/**
+ * @brief Snapshot of the statistics of every lazy service type used so far
+ * 
+ * Empty unless DI_LAZY_STATS is defined.
+ */
+inline std::vector<LazyStats> lazy_stats() {
+    std::vector<LazyStats> stats;
+    detail::lazy_stats_registry::instance().for_each([&](detail::lazy_counters const &c) {
+        stats.push_back(LazyStats{
+            c.type,
+            c.accesses.load(std::memory_order_relaxed),
+            c.creations.load(std::memory_order_relaxed),
+            c.factory_ns.load(std::memory_order_relaxed),
+            c.waiters.load(std::memory_order_relaxed),
+            c.wait_ns.load(std::memory_order_relaxed),
+        });
+    });
+    return stats;
+}
+
+/**
+ * @brief Statistics of one service type (all zero if it was never used lazily)
+ * 
+ * @tparam T The service type
+ */
+template <typename T>
+LazyStats lazy_stats_of() {
+    auto const name = detail::type_name<std::remove_const_t<T>>();
+    for(auto &stats : lazy_stats())
+        if(stats.type == name)
+            return stats;
+    return LazyStats{ std::string{ name } };
+}
+
+/**
+ * @brief Zero all counters (e.g. between measurements)
+ */
+inline void reset_lazy_stats() {
+    detail::lazy_stats_registry::instance().for_each([](detail::lazy_counters &c) {
+        c.accesses.store(0, std::memory_order_relaxed);
+        c.creations.store(0, std::memory_order_relaxed);
+        c.factory_ns.store(0, std::memory_order_relaxed);
+        c.waiters.store(0, std::memory_order_relaxed);
+        c.wait_ns.store(0, std::memory_order_relaxed);
+    });
+}
+
+/**
+ * @brief All statistics as a JSON array of objects, one per service type
+ */
+inline std::string lazy_stats_json() {
+    std::string json = "[";
+    auto first       = true;
+    for(auto const &stats : lazy_stats()) {
+        json += first ? "\n  {" : ",\n  {";
+        first = false;
+
+        json += "\"type\": \"";
+        for(auto c : stats.type) {
+            if(c == '"' or c == '\\')
+                json += '\\';
+            json += c;
+        }
+        json += "\", \"accesses\": " + std::to_string(stats.accesses);
+        json += ", \"creations\": " + std::to_string(stats.creations);
+        json += ", \"factory_ns\": " + std::to_string(stats.factory_ns);
+        json += ", \"waiters\": " + std::to_string(stats.waiters);
+        json += ", \"wait_ns\": " + std::to_string(stats.wait_ns);
+        json += "}";
+    }
+    json += first ? "]" : "\n]";
+    return json;
+}
+
+} // namespace di
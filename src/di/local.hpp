@@ -0,0 +1,180 @@
+#pragma once
+
+#include <di/selection.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace di {
+
+namespace detail {
+
+/**
+ * @brief Control block of a LocalPtr, counted without atomics
+ * 
+ * Remembers its creating thread; debug builds assert that every
+ * count change and access happens on that thread.
+ */
+struct local_block {
+    std::size_t refs      = 1;
+    std::thread::id owner = std::this_thread::get_id();
+
+    virtual ~local_block() = default;
+
+    void check() const noexcept {
+        assert(owner == std::this_thread::get_id() && "LocalPtr used from another thread");
+    }
+};
+
+template <typename V>
+struct local_object_block : local_block {
+    V value;
+
+    template <typename... Args>
+    explicit local_object_block(Args &&... args)
+        : value(std::forward<Args>(args)...) {}
+};
+
+} // namespace detail
+
+template <typename T>
+class LocalPtr;
+
+template <typename T, typename... Args>
+LocalPtr<T> make_local(Args &&... args);
+
+/**
+ * @brief A single-threaded shared pointer, usable as the holder type of a Selection.
+ * 
+ * Behaves like `std::shared_ptr` but counts references without atomic
+ * instructions, for services that never leave the thread that created them
+ * (e.g. one event loop per thread). The object and its count live in one
+ * allocation made by @ref make_local.
+ * 
+ * Copying, destroying or dereferencing a LocalPtr on another thread than the
+ * creating one is undefined; debug builds (without NDEBUG) assert on it.
+ * 
+ * A LocalPtr<T> converts to a LocalPtr<const T> sharing the same count.
+ * 
+ * @tparam T
+ */
+template <typename T>
+class LocalPtr {
+    detail::local_block *block_ = nullptr;
+    T *ptr_                     = nullptr;
+
+    template <typename>
+    friend class LocalPtr;
+
+    template <typename U, typename... Args>
+    friend LocalPtr<U> make_local(Args &&... args);
+
+    LocalPtr(detail::local_block *block, T *ptr) noexcept
+        : block_{ block }
+        , ptr_{ ptr } {}
+
+public:
+    LocalPtr() noexcept = default;
+
+    LocalPtr(LocalPtr const &other) noexcept
+        : block_{ other.block_ }
+        , ptr_{ other.ptr_ } {
+        retain();
+    }
+
+    LocalPtr(LocalPtr &&other) noexcept
+        : block_{ std::exchange(other.block_, nullptr) }
+        , ptr_{ std::exchange(other.ptr_, nullptr) } {}
+
+    /**
+     * @brief Promote a pointer to non-const T to a pointer to const T.
+     * 
+     * @param other The pointer to share the count with
+     */
+    template <typename U>
+    LocalPtr(LocalPtr<U> const &other) noexcept requires std::is_same_v<T, U const>
+        : block_{ other.block_ }
+        , ptr_{ other.ptr_ } {
+        retain();
+    }
+
+    template <typename U>
+    LocalPtr(LocalPtr<U> &&other) noexcept requires std::is_same_v<T, U const>
+        : block_{ std::exchange(other.block_, nullptr) }
+        , ptr_{ std::exchange(other.ptr_, nullptr) } {}
+
+    LocalPtr &operator=(LocalPtr other) noexcept {
+        std::swap(block_, other.block_);
+        std::swap(ptr_, other.ptr_);
+        return *this;
+    }
+
+    ~LocalPtr() {
+        if(block_) {
+            block_->check();
+            if(--block_->refs == 0)
+                delete block_;
+        }
+    }
+
+    T *get() const noexcept {
+        return ptr_;
+    }
+
+    T *operator->() const noexcept {
+        assert(block_);
+        block_->check();
+        return ptr_;
+    }
+
+    T &operator*() const noexcept {
+        return *operator->();
+    }
+
+    explicit operator bool() const noexcept {
+        return ptr_ != nullptr;
+    }
+
+    std::size_t use_count() const noexcept {
+        return block_ ? block_->refs : 0;
+    }
+
+private:
+    void retain() const noexcept {
+        if(block_) {
+            block_->check();
+            ++block_->refs;
+        }
+    }
+};
+
+/**
+ * @brief Create an object owned by a LocalPtr, in a single allocation
+ * 
+ * @tparam T The object type (possibly const)
+ * @param args Constructor arguments
+ * @return LocalPtr<T> The only owner of the new object
+ */
+template <typename T, typename... Args>
+LocalPtr<T> make_local(Args &&... args) {
+    auto block = new detail::local_object_block<std::remove_const_t<T>>(std::forward<Args>(args)...);
+    return LocalPtr<T>{ block, &block->value };
+}
+
+/**
+ * @brief Selections of LocalPtr can default-construct their services
+ */
+template <>
+struct holder_traits<LocalPtr> {
+    static constexpr bool borrowing = false;
+
+    template <typename T>
+    static LocalPtr<T> make() {
+        return make_local<T>();
+    }
+};
+
+} // namespace di
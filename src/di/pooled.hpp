@@ -0,0 +1,262 @@
+#pragma once
+
+#include <di/selection.hpp>
+#include <di/thread_slot.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace di {
+
+/**
+ * @brief Sizing of the pool behind a @ref PooledHolder
+ */
+struct PoolOptions {
+    std::size_t capacity = 64; /*! Max amount of idle objects kept for reuse */
+    std::size_t prefill  = 0;  /*! Amount of objects created upfront */
+    std::size_t shards   = std::max(1u, std::thread::hardware_concurrency()); /*! Capped at capacity */
+};
+
+namespace detail {
+
+/**
+ * @brief Thread-safe pool of reusable objects
+ * 
+ * Idle objects are kept in shards, each thread preferring its own shard,
+ * so threads mostly lock an uncontended mutex of their own.
+ * 
+ * @tparam V The non-const object type
+ */
+template <typename V>
+class object_pool {
+    using ptr_t = std::unique_ptr<V>;
+
+    struct alignas(64) shard {
+        std::mutex mtx;
+        std::vector<ptr_t> idle;
+        std::size_t capacity = 0;
+    };
+
+    std::function<ptr_t()> factory_;
+    std::function<void(V &)> reset_;
+    std::vector<shard> shards_;
+
+public:
+    /**
+     * @brief Splits the capacity over the shards, using no more shards than capacity allows
+     */
+    object_pool(std::function<ptr_t()> factory, std::function<void(V &)> reset, PoolOptions const &options)
+        : factory_{ std::move(factory) }
+        , reset_{ std::move(reset) }
+        , shards_(std::clamp<std::size_t>(options.shards, 1, std::max<std::size_t>(options.capacity, 1))) {
+        for(std::size_t i = 0; i < shards_.size(); ++i) {
+            shards_[i].capacity = options.capacity / shards_.size() + (i < options.capacity % shards_.size() ? 1 : 0);
+            shards_[i].idle.reserve(shards_[i].capacity);
+        }
+        for(std::size_t i = 0; i < std::min(options.prefill, options.capacity); ++i)
+            shards_[i % shards_.size()].idle.push_back(factory_());
+    }
+
+    /**
+     * @brief Take an idle object (from the own shard first) or create a new one
+     */
+    ptr_t acquire() {
+        auto const own = thread_slot() % shards_.size();
+        if(auto object = pop(shards_[own]))
+            return object;
+
+        for(std::size_t i = 1; i < shards_.size(); ++i) {
+            auto &other = shards_[(own + i) % shards_.size()];
+            std::unique_lock<std::mutex> lock(other.mtx, std::try_to_lock);
+            if(lock.owns_lock() and not other.idle.empty()) {
+                auto object = std::move(other.idle.back());
+                other.idle.pop_back();
+                return object;
+            }
+        }
+
+        return factory_();
+    }
+
+    /**
+     * @brief Reset the object and keep it for reuse unless the shard is full
+     */
+    void release(ptr_t object) {
+        if(reset_)
+            reset_(*object);
+
+        auto &own = shards_[thread_slot() % shards_.size()];
+        std::lock_guard<std::mutex> g(own.mtx);
+        if(own.idle.size() < own.capacity)
+            own.idle.push_back(std::move(object));
+        // otherwise object is destroyed (after unlocking)
+    }
+
+    /**
+     * @brief Amount of idle objects across all shards
+     */
+    std::size_t idle() {
+        std::size_t count = 0;
+        for(auto &s : shards_) {
+            std::lock_guard<std::mutex> g(s.mtx);
+            count += s.idle.size();
+        }
+        return count;
+    }
+
+private:
+    static ptr_t pop(shard &s) {
+        std::lock_guard<std::mutex> g(s.mtx);
+        if(s.idle.empty())
+            return nullptr;
+        auto object = std::move(s.idle.back());
+        s.idle.pop_back();
+        return object;
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Exclusive use of a pooled object; returns it to the pool when destroyed
+ * 
+ * A lease must not outlive the @ref PooledHolder it was acquired from.
+ * 
+ * @tparam T
+ */
+template <typename T>
+class Lease {
+    using value_t = std::remove_const_t<T>;
+
+    detail::object_pool<value_t> *pool_;
+    std::unique_ptr<value_t> object_;
+
+public:
+    Lease(detail::object_pool<value_t> *pool, std::unique_ptr<value_t> object) noexcept
+        : pool_{ pool }
+        , object_{ std::move(object) } {}
+
+    Lease(Lease &&) noexcept = default;
+    Lease &operator=(Lease &&other) noexcept {
+        if(this != &other) {
+            if(object_)
+                pool_->release(std::move(object_));
+            pool_   = other.pool_;
+            object_ = std::move(other.object_);
+        }
+        return *this;
+    }
+
+    ~Lease() {
+        if(object_)
+            pool_->release(std::move(object_));
+    }
+
+    T *get() const noexcept { return object_.get(); }
+    T *operator->() const noexcept { return object_.get(); }
+    T &operator*() const noexcept { return *object_; }
+};
+
+/**
+ * @brief A Selection holder type handing out objects from a pool.
+ * 
+ * Meant for transient, expensive-to-construct services (codec contexts, hash
+ * states with large tables) that are used for one job at a time. Instead of
+ * being destroyed, a released object is passed through the optional reset
+ * hook and kept for the next job, up to PoolOptions::capacity idle objects.
+ * 
+ * Every access leases an object exclusively. With `operator->` the lease lasts
+ * until the end of the full expression:
+ * @code
+ *   services.get<Hasher>()->hash(data); // leased and returned right away
+ *   auto hasher = services.get<Hasher>().acquire(); // leased until hasher dies
+ * @endcode
+ * 
+ * Copies share the pool. A PooledHolder<T> converts to a PooledHolder<const T>
+ * sharing the same pool.
+ * 
+ * @tparam T
+ */
+template <typename T>
+class PooledHolder {
+    using value_t = std::remove_const_t<T>;
+    using data_t  = std::shared_ptr<detail::object_pool<value_t>>;
+
+    data_t data_;
+
+    template <typename>
+    friend class PooledHolder;
+
+public:
+    /**
+     * @brief Pool default-constructed objects.
+     * 
+     * @param options Pool sizing
+     */
+    explicit PooledHolder(PoolOptions const &options = {}) requires std::is_default_constructible_v<value_t>
+        : PooledHolder([] { return value_t(); }, options) {}
+
+    /**
+     * @brief Pool objects created by a factory.
+     * 
+     * @tparam Fn Any function or lambda returning T by value or as `std::unique_ptr<T>`
+     * @param factory Creates new objects when no idle one is available
+     * @param options Pool sizing
+     * @param reset Called with each released object before it is reused
+     */
+    template <typename Fn>
+    PooledHolder(Fn factory, PoolOptions const &options = {}, std::function<void(value_t &)> reset = {}) requires std::is_invocable_v<Fn &>
+        : data_{ std::make_shared<detail::object_pool<value_t>>(
+            [factory = std::move(factory)]() mutable {
+                if constexpr(std::is_same_v<std::invoke_result_t<Fn &>, value_t>)
+                    return std::make_unique<value_t>(factory());
+                else
+                    return std::unique_ptr<value_t>(factory());
+            },
+            std::move(reset), options) } {
+    }
+
+    /**
+     * @brief Promote a holder of non-const T to a holder of const T.
+     * 
+     * @param other The holder to share the pool with
+     */
+    template <typename U>
+    PooledHolder(PooledHolder<U> const &other) requires std::is_same_v<T, U const>
+        : data_{ other.data_ } {
+    }
+
+    /**
+     * @brief Lease an object from the pool.
+     * 
+     * @return Lease<T> Returns the object to the pool when destroyed
+     */
+    Lease<T> acquire() const {
+        return Lease<T>{ data_.get(), data_->acquire() };
+    }
+
+    /**
+     * @brief Lease an object for the duration of the full expression.
+     * 
+     * @return Lease<T> Its `operator->` gives access to the object
+     */
+    Lease<T> operator->() const {
+        return acquire();
+    }
+
+    /**
+     * @brief Amount of idle objects currently kept in the pool.
+     */
+    std::size_t idle() const {
+        return data_->idle();
+    }
+};
+
+} // namespace di
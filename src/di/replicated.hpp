@@ -0,0 +1,220 @@
+#pragma once
+
+#include <di/selection.hpp>
+#include <di/thread_slot.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace di {
+
+/**
+ * @brief How a @ref ReplicatedHolder picks the replica for the calling thread
+ */
+enum class ReplicaBy {
+    cpu,    /*! The CPU the thread currently runs on (falls back to thread where unavailable) */
+    thread, /*! A stable per-thread index */
+};
+
+/**
+ * @brief Sharding of a @ref ReplicatedHolder
+ */
+struct ReplicaOptions {
+    std::size_t shards = std::max(1u, std::thread::hardware_concurrency());
+    ReplicaBy by       = ReplicaBy::cpu;
+};
+
+namespace detail {
+
+/**
+ * @brief One copy of a replicated service, on cache lines of its own
+ */
+template <typename V>
+struct alignas(64) replica_storage {
+    V value;
+};
+
+/**
+ * @brief The copies of a replicated service
+ * 
+ * The set is owned through one control block per shard (see owner()), so
+ * copying a holder only counts on the calling shard.
+ * 
+ * @tparam V The non-const service type
+ */
+template <typename V>
+struct replica_set {
+    struct alignas(64) shard {
+        std::shared_ptr<V const> ptr;           /*! Own control block, so sharing stays shard-local */
+        std::weak_ptr<replica_set const> owner; /*! Own control block owning the set, while pinned or used */
+    };
+
+    std::vector<shard> shards;
+    ReplicaBy by;
+
+    std::size_t index() const noexcept {
+#if defined(__linux__)
+        if(by == ReplicaBy::cpu) {
+            auto const cpu = sched_getcpu();
+            if(cpu >= 0)
+                return static_cast<std::size_t>(cpu) % shards.size();
+        }
+#endif
+        return thread_slot() % shards.size();
+    }
+
+    shard const &local() const noexcept {
+        return shards[index()];
+    }
+
+    /**
+     * @brief Share the set through the calling shard's control block
+     * 
+     * Falls back to sharing fallback's control block once the shard's
+     * one expired (no pinning holder and no holder on that shard left).
+     */
+    std::shared_ptr<replica_set const> owner(std::shared_ptr<replica_set const> const &fallback) const noexcept {
+        if(auto local_owner = local().owner.lock())
+            return local_owner;
+        return fallback;
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief A Selection holder type keeping one copy of a read-only service per CPU (or shard).
+ * 
+ * Meant for const services read on every request (routing tables, config
+ * snapshots). Every reader uses the copy of the CPU (or thread) it runs on, so
+ * cores neither share the object's cache lines nor any control block, be it
+ * when copying the holder (e.g. `Selection::get`) or when taking a reference
+ * with `operator*`:
+ * @code
+ *   auto services = ReplicatedServices<const Routes>{ ReplicatedHolder<const Routes>{ routes } };
+ *   services.get<Routes>()->find(path); // counts and reads on the local shard only
+ * @endcode
+ * 
+ * A holder created from a factory or value (and holders moved from it) keeps
+ * every shard's control block alive; copies count on the shard they were made
+ * on. Once all holders created from a factory or value are gone, copies
+ * made on shards without other holders share their source's control block.
+ * 
+ * Only const services can be replicated: a replicated service is immutable.
+ * 
+ * @tparam T The (const) service type
+ */
+template <typename T>
+class ReplicatedHolder {
+    static_assert(std::is_const_v<T>, "Only const services can be replicated");
+
+    using value_t = std::remove_const_t<T>;
+    using data_t  = std::shared_ptr<detail::replica_set<value_t> const>;
+    using pins_t  = std::shared_ptr<std::vector<data_t> const>;
+
+    data_t data_; /*! Counted on the shard this holder was made on */
+    pins_t pins_; /*! Every shard's control block, only in holders created from a factory or value */
+
+public:
+    /**
+     * @brief Create each copy with a factory.
+     * 
+     * @tparam Fn Any function or lambda returning T by value, called once per shard
+     * @param factory Creates the copies
+     * @param options Amount of copies and how to pick them
+     */
+    template <typename Fn>
+    ReplicatedHolder(Fn factory, ReplicaOptions const &options = {}) requires std::is_invocable_v<Fn &> and std::is_same_v<std::invoke_result_t<Fn &>, value_t> {
+        auto set = std::make_shared<detail::replica_set<value_t>>();
+        set->by  = options.by;
+        set->shards.resize(std::max<std::size_t>(options.shards, 1));
+
+        auto pins = std::make_shared<std::vector<data_t>>();
+        for(auto &shard : set->shards) {
+            auto storage = std::make_shared<detail::replica_storage<value_t>>(factory());
+            shard.ptr    = std::shared_ptr<value_t const>(storage, &storage->value);
+
+            // the shard's own control block, keeping the set alive until it expires
+            // (the deleter lives as long as the set's weak_ptr to it, so it lets go when called)
+            auto owner  = data_t{ set.get(), [set](auto const *) mutable { set.reset(); } };
+            shard.owner = owner;
+            pins->push_back(std::move(owner));
+        }
+        data_ = set->owner(nullptr);
+        pins_ = std::move(pins);
+    }
+
+    /**
+     * @brief Copy a value into each shard.
+     * 
+     * @param value The service to replicate
+     * @param options Amount of copies and how to pick them
+     */
+    ReplicatedHolder(value_t const &value, ReplicaOptions const &options = {}) requires std::is_copy_constructible_v<value_t>
+        : ReplicatedHolder([&value] { return value; }, options) {
+    }
+
+    /**
+     * @brief Share the set through the calling thread's shard.
+     */
+    ReplicatedHolder(ReplicatedHolder const &other) noexcept
+        : data_{ other.data_->owner(other.data_) } {
+    }
+
+    ReplicatedHolder(ReplicatedHolder &&) noexcept = default;
+
+    ReplicatedHolder &operator=(ReplicatedHolder const &other) noexcept {
+        if(this != &other) {
+            data_ = other.data_->owner(other.data_);
+            pins_ = nullptr;
+        }
+        return *this;
+    }
+
+    ReplicatedHolder &operator=(ReplicatedHolder &&) noexcept = default;
+
+    /**
+     * @brief The copy of the calling thread's shard.
+     */
+    T *get() const noexcept {
+        return data_->local().ptr.get();
+    }
+
+    T *operator->() const noexcept {
+        return get();
+    }
+
+    /**
+     * @brief Share the copy of the calling thread's shard.
+     * 
+     * @return std::shared_ptr<T> Counted on a shard-local control block
+     */
+    std::shared_ptr<T> operator*() const noexcept {
+        return data_->local().ptr;
+    }
+
+    /**
+     * @brief Amount of copies.
+     */
+    std::size_t shards() const noexcept {
+        return data_->shards.size();
+    }
+
+    /**
+     * @brief Amount of holders counted on the same control block as this one.
+     */
+    long use_count() const noexcept {
+        return data_.use_count();
+    }
+};
+
+} // namespace di
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <di/selection.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <utility>
+
+namespace di {
+
+/**
+ * @brief Owns a monotonic arena for short-lived (e.g. per-request) services
+ * 
+ * Services created by the scope are allocated, along with their control
+ * blocks, from the arena. They are regular `std::shared_ptr`s and combine
+ * with long-lived services through the usual machinery:
+ * @code
+ *   auto request = combine(singletons, scope.services<Parser, Buffer>());
+ *   handle(request);
+ *   scope.reset(); // once every scoped service is gone
+ * @endcode
+ * 
+ * Destroying a scoped service runs its destructor but frees nothing;
+ * all memory is released in one go by reset() (or when the scope dies).
+ * A scope is meant to be used by one request at a time and is not thread-safe.
+ */
+class Scope {
+    /**
+     * @brief Counts live allocations on top of the monotonic arena
+     */
+    class counting_resource : public std::pmr::memory_resource {
+        std::pmr::memory_resource *upstream_;
+        std::size_t live_ = 0;
+
+    public:
+        explicit counting_resource(std::pmr::memory_resource *upstream)
+            : upstream_{ upstream } {}
+
+        std::size_t live() const noexcept {
+            return live_;
+        }
+
+    private:
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+            auto ptr = upstream_->allocate(bytes, alignment);
+            ++live_;
+            return ptr;
+        }
+
+        void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) override {
+            upstream_->deallocate(ptr, bytes, alignment); // no-op for the arena
+            --live_;
+        }
+
+        bool do_is_equal(std::pmr::memory_resource const &other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    std::pmr::monotonic_buffer_resource arena_;
+    counting_resource resource_{ &arena_ };
+
+public:
+    /**
+     * @brief Create a scope whose arena grows from the heap
+     * 
+     * @param initial_size Size of the first chunk requested from the heap
+     */
+    explicit Scope(std::size_t initial_size = 4096)
+        : arena_{ initial_size } {}
+
+    /**
+     * @brief Create a scope whose arena starts in a caller-provided buffer
+     * 
+     * The buffer is reused after each reset(), so scopes fitting into it
+     * never touch the heap.
+     * 
+     * @param buffer Memory to carve services from; must outlive the scope
+     */
+    explicit Scope(std::span<std::byte> buffer)
+        : arena_{ buffer.data(), buffer.size() } {}
+
+    Scope(Scope const &) = delete;
+    Scope &operator=(Scope const &) = delete;
+
+    ~Scope() {
+        assert(resource_.live() == 0 && "Scoped services must not outlive their scope");
+    }
+
+    /**
+     * @brief Create one scoped service
+     * 
+     * @tparam T The service type
+     * @param args Constructor arguments
+     * @return std::shared_ptr<T> Allocated from the arena
+     */
+    template <typename T, typename... Args>
+    std::shared_ptr<T> create(Args &&... args) {
+        return std::allocate_shared<T>(
+            std::pmr::polymorphic_allocator<T>{ &resource_ }, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Default-construct a selection of scoped services
+     * 
+     * @tparam Types The services to create
+     * @return Selection<std::shared_ptr, Types...> Combinable with any other Services
+     */
+    template <typename... Types>
+    Selection<std::shared_ptr, Types...> services() {
+        return Selection<std::shared_ptr, Types...>{ create<std::remove_const_t<Types>>()... };
+    }
+
+    /**
+     * @brief Amount of scoped services (and other arena allocations) still alive
+     */
+    std::size_t live() const noexcept {
+        return resource_.live();
+    }
+
+    /**
+     * @brief Release all memory of the scope at once
+     * 
+     * Every service created by the scope must already be destroyed.
+     */
+    void reset() {
+        assert(resource_.live() == 0 && "Scoped services must not outlive their scope");
+        arena_.release();
+    }
+};
+
+} // namespace di
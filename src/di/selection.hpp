@@ -1,11 +1,14 @@
 #pragma once
 
+#include <di/trace_hook.hpp>
 #include <di/util.hpp>
 
+#include <concepts>
 #include <functional>
 #include <memory>
 #include <tuple>
-#include <variant>
+#include <type_traits>
+#include <utility>
 
 namespace di {
 
@@ -16,7 +19,7 @@ namespace di {
  * @tparam Types 
  */
 template <typename T, typename... Types>
-concept NonConstServiceStored = any_type_match<std::decay_t<T>, Types...>::value;
+concept NonConstServiceStored = MappedOnce<std::decay_t<T>, type_index_map<Types...>>;
 
 /**
  * @brief A requirement for T to be stored as a const in Types
@@ -25,7 +28,7 @@ concept NonConstServiceStored = any_type_match<std::decay_t<T>, Types...>::value
  * @tparam Types 
  */
 template <typename T, typename... Types>
-concept ConstServiceStored = any_type_match<std::add_const_t<T>, Types...>::value;
+concept ConstServiceStored = MappedOnce<std::add_const_t<T>, type_index_map<Types...>>;
 
 /**
  * @brief A requirement that type T is actually available in some way in Types
@@ -34,7 +37,7 @@ concept ConstServiceStored = any_type_match<std::add_const_t<T>, Types...>::valu
  * @tparam Types 
  */
 template <typename T, typename... Types>
-concept ServiceIsStored = any_type_match<std::decay_t<T>, std::decay_t<Types>...>::value;
+concept ServiceIsStored = MappedOnce<std::decay_t<T>, type_index_map<std::decay_t<Types>...>>;
 
 /**
  * @brief A requirement for Types to be a pack of at least two types
@@ -52,6 +55,98 @@ concept TwoOrMoreInPack = sizeof...(Types) >= 2;
 template <typename... Types>
 concept EachIsUnique = check_unique<std::decay_t<Types>...>::value;
 
+/**
+ * @brief Tag requesting all services of a selection to be placed in one allocation
+ */
+struct in_arena_t {
+    explicit in_arena_t() = default;
+};
+inline constexpr in_arena_t in_arena{};
+
+/**
+ * @brief Describes how a holder type interacts with Selection
+ * 
+ * Specialize for a holder to opt into extra behavior.
+ * 
+ * @tparam HolderType 
+ */
+template <template <typename> typename HolderType>
+struct holder_traits {
+    /*! Whether a selection of this holder can borrow from selections of any other holder */
+    static constexpr bool borrowing = false;
+};
+
+/**
+ * @brief A requirement for selections of other holders to be buildable from selections of HolderType
+ * 
+ * Opted into by a `static constexpr bool converting = true` in holder_traits;
+ * each holder is then converted to the holder type of the receiving selection.
+ * 
+ * @tparam HolderType 
+ */
+template <template <typename> typename HolderType>
+concept ConvertingHolder = requires {
+    requires holder_traits<HolderType>::converting;
+};
+
+/**
+ * @brief A requirement for a selection to provide T in a holder convertible to HolderType<T>
+ * 
+ * @tparam Sel The selection to get T from
+ * @tparam HolderType The holder type to convert to
+ * @tparam T 
+ */
+template <typename Sel, template <typename> typename HolderType, typename T>
+concept ProvidesConvertible = requires(Sel const &selection) {
+    { selection.template get<T>() } -> std::convertible_to<HolderType<T>>;
+};
+
+/**
+ * @brief Selections of shared_ptr can default-construct their services
+ */
+template <>
+struct holder_traits<std::shared_ptr> {
+    static constexpr bool borrowing = false;
+
+    template <typename T>
+    static std::shared_ptr<T> make() {
+        return std::make_shared<T>();
+    }
+};
+
+/**
+ * @brief A requirement for HolderType to be able to default-construct a T (see holder_traits)
+ * 
+ * @tparam HolderType 
+ * @tparam T 
+ */
+template <template <typename> typename HolderType, typename T>
+concept HolderCanMake = requires {
+    { holder_traits<HolderType>::template make<T>() } -> std::convertible_to<HolderType<T>>;
+};
+
+namespace detail {
+
+template <template <typename> typename HolderType, typename T>
+HolderType<T> traced_runtime_make() {
+    auto span = trace_construction<T>("services");
+    return holder_traits<HolderType>::template make<T>();
+}
+
+/**
+ * @brief Default-construct T in its holder, traced as a "services" construction
+ * 
+ * Constant initialization (e.g. a constinit selection) runs nothing to trace.
+ */
+template <template <typename> typename HolderType, typename T>
+constexpr HolderType<T> traced_make() {
+    if(std::is_constant_evaluated())
+        return holder_traits<HolderType>::template make<T>();
+    return traced_runtime_make<HolderType, T>();
+}
+
+} // namespace detail
+
 /**
  * @brief Represents a selection of Selection that can be passed around cheaply
  * 
@@ -62,15 +157,27 @@ concept EachIsUnique = check_unique<std::decay_t<Types>...>::value;
  */
 template <template <typename> typename HolderType, typename... Types>
 requires EachIsUnique<Types...> class Selection {
-    using data_t = std::tuple<HolderType<Types>...>;
+    using data_t = indexed_tuple<HolderType<Types>...>;
     data_t data_;
 
 public:
     /**
-     * @brief Default-constructs each service and stores it as a shared_ptr
+     * @brief Default-constructs each service and stores it in its holder (e.g. a shared_ptr)
      */
-    constexpr Selection() requires std::is_same_v<HolderType<void>, std::shared_ptr<void>>
-        : data_{ std::make_shared<Types>()... } {}
+    constexpr Selection() requires(HolderCanMake<HolderType, Types> &&...)
+        : data_{ detail::traced_make<HolderType, Types>()... } {}
+
+    /**
+     * @brief Default-constructs all services next to each other in a single allocation
+     * 
+     * Each stored shared_ptr aliases the one shared block, so the services
+     * are only destroyed (together) once none of them is referenced anymore.
+     * @code
+     *   auto services = Services<A, B, C>{ di::in_arena };
+     * @endcode
+     */
+    constexpr explicit Selection(in_arena_t) requires std::is_same_v<HolderType<void>, std::shared_ptr<void>>
+        : data_{ from_arena(std::make_shared<std::tuple<std::remove_const_t<Types>...>>(), std::index_sequence_for<Types...>{}) } {}
 
     /**
      * @brief Construct a selection directly from data to be stored
@@ -78,7 +185,7 @@ public:
      * @param ts The data to store
      */
     constexpr Selection(HolderType<Types>... ts)
-        : data_{ ts... } {}
+        : data_{ std::move(ts)... } {}
 
     /**
      * @brief Constructs a new (possibly narrower) selection by copying relevant Selection
@@ -88,9 +195,57 @@ public:
      */
     template <typename... SenderTypes>
     constexpr Selection(Selection<HolderType, SenderTypes...> const &other) requires(ServiceIsStored<Types, SenderTypes...> &&...)
-        : data_(other.template get<Types...>()) {
+        : data_{ other.template get<Types>()... } {
+    }
+
+    /**
+     * @brief Constructs a new (possibly narrower) selection by moving relevant holders out of other
+     * 
+     * Holders of other not selected by Types are left untouched.
+     * 
+     * @tparam SenderTypes (required for each type in Types to also be in SenderTypes)
+     * @param other The (possibly wider) Selection selection
+     */
+    template <typename... SenderTypes>
+    constexpr Selection(Selection<HolderType, SenderTypes...> &&other) requires(ServiceIsStored<Types, SenderTypes...> &&...)
+        : data_{ std::move(other).template get<Types>()... } {
+    }
+
+    /**
+     * @brief Constructs a borrowing selection from a selection with another holder type
+     * 
+     * Each holder is built from a reference to the holder stored in other,
+     * so no holder of other is copied.
+     * 
+     * @tparam OtherHolderType Holder type of the selection to borrow from
+     * @tparam SenderTypes (required for each type in Types to also be in SenderTypes)
+     * @param other The (possibly wider) selection to borrow from
+     */
+    template <template <typename> typename OtherHolderType, typename... SenderTypes>
+    constexpr Selection(Selection<OtherHolderType, SenderTypes...> const &other) requires holder_traits<HolderType>::borrowing &&(ServiceIsStored<Types, SenderTypes...> &&...)
+        : data_{ HolderType<Types>(other.template stored<Types>())... } {
+    }
+
+    /**
+     * @brief Constructs a selection from a selection of a converting holder type (see ConvertingHolder)
+     * 
+     * E.g. a Services consumer accepting a StaticServices.
+     * 
+     * @tparam OtherHolderType Holder type of the selection to convert from
+     * @tparam SenderTypes (each type in Types has to be provided convertibly by other)
+     * @param other The (possibly wider) selection to convert from
+     */
+    template <template <typename> typename OtherHolderType, typename... SenderTypes>
+    constexpr Selection(Selection<OtherHolderType, SenderTypes...> const &other) requires(not holder_traits<HolderType>::borrowing) && ConvertingHolder<OtherHolderType> &&(ProvidesConvertible<Selection<OtherHolderType, SenderTypes...>, HolderType, Types> &&...)
+        : data_{ HolderType<Types>(other.template get<Types>())... } {
     }
 
+    /**
+     * @brief Borrowing from an expiring selection would leave dangling holders
+     */
+    template <template <typename> typename OtherHolderType, typename... SenderTypes>
+    Selection(Selection<OtherHolderType, SenderTypes...> &&other) requires holder_traits<HolderType>::borrowing &&(ServiceIsStored<Types, SenderTypes...> &&...) = delete;
+
     /**
      * @brief Get a service by its type
      * 
@@ -101,8 +256,19 @@ public:
      * @return HolderType<T> 
      */
     template <typename T>
-    constexpr HolderType<T> get() const requires NonConstServiceStored<T, Types...> {
-        return std::get<HolderType<std::decay_t<T>>>(data_);
+    constexpr HolderType<T> get() const & requires NonConstServiceStored<T, Types...> {
+        return detail::element_at<index_in<std::decay_t<T>, Types...>>(data_);
+    }
+
+    /**
+     * @brief Move a service out of an expiring selection
+     * 
+     * @tparam T The type of service (required to be stored as non-const)
+     * @return HolderType<T> 
+     */
+    template <typename T>
+    constexpr HolderType<T> get() && requires NonConstServiceStored<T, Types...> {
+        return detail::element_at<index_in<std::decay_t<T>, Types...>>(std::move(data_));
     }
 
     /**
@@ -112,8 +278,19 @@ public:
      * @return std::shared_ptr<const T> 
      */
     template <typename T>
-    constexpr HolderType<const T> get() const requires ConstServiceStored<T, Types...> {
-        return std::get<HolderType<const T>>(data_);
+    constexpr HolderType<const T> get() const & requires ConstServiceStored<T, Types...> {
+        return detail::element_at<index_in<const T, Types...>>(data_);
+    }
+
+    /**
+     * @brief Move a const service out of an expiring selection
+     * 
+     * @tparam T The type of service (required to be stored as const)
+     * @return HolderType<const T> 
+     */
+    template <typename T>
+    constexpr HolderType<const T> get() && requires ConstServiceStored<T, Types...> {
+        return detail::element_at<index_in<const T, Types...>>(std::move(data_));
     }
 
     /**
@@ -128,29 +305,45 @@ public:
      * @return auto Roughly std::tuple<std::shared_ptr<Ts>...>
      */
     template <typename... Ts>
-    constexpr std::tuple<HolderType<Ts>...> get() const requires TwoOrMoreInPack<Ts...> {
+    constexpr std::tuple<HolderType<Ts>...> get() const & requires TwoOrMoreInPack<Ts...> {
         return std::make_tuple<HolderType<Ts>...>(get<Ts>()...);
     }
 
+    /**
+     * @brief Move multiple services out of an expiring selection at once
+     * 
+     * @tparam Ts
+     * @return auto Roughly std::tuple<std::shared_ptr<Ts>...>
+     */
+    template <typename... Ts>
+    constexpr std::tuple<HolderType<Ts>...> get() && requires TwoOrMoreInPack<Ts...> {
+        return std::tuple<HolderType<Ts>...>{ std::move(*this).template get<Ts>()... };
+    }
+
 private:
+    template <typename Arena, std::size_t... Is>
+    static constexpr data_t from_arena(std::shared_ptr<Arena> const &arena, std::index_sequence<Is...>) {
+        return data_t{ HolderType<Types>(arena, std::addressof(std::get<Is>(*arena)))... };
+    }
+
+    /**
+     * @brief Reference to the holder stored for T (without copying it)
+     * 
+     * @tparam T The type of service (either as stored or as const)
+     */
+    template <typename T>
+    constexpr auto const &stored() const {
+        if constexpr(NonConstServiceStored<T, Types...>)
+            return detail::element_at<index_in<std::decay_t<T>, Types...>>(data_);
+        else
+            return detail::element_at<index_in<const T, Types...>>(data_);
+    }
+
+    template <template <typename> typename, typename... Ts>
+    requires EachIsUnique<Ts...> friend class Selection;
+
     template <typename... Ts>
-    friend constexpr decltype(auto) get(auto const &selection);
-
-    template <template <typename> typename HType, typename... SenderTypes, typename... OtherTypes>
-    friend constexpr Selection<HType, SenderTypes..., OtherTypes...> extend(
-        Selection<HType, SenderTypes...> const &selection,
-        HType<OtherTypes>... others);
-
-    template <template <typename> typename HType, typename... LTypes, typename... RTypes>
-    friend constexpr Selection<HType, LTypes..., RTypes...> combine(
-        Selection<HType, LTypes...> const &lhs,
-        Selection<HType, RTypes...> const &rhs);
-
-    template <typename LService, typename MService, typename... Others>
-    friend constexpr auto combine(
-        LService const &lhs,
-        MService const &mid,
-        Others const &... others) -> decltype(auto);
+    friend constexpr decltype(auto) get(auto &&selection);
 };
 
 } // namespace di
\ No newline at end of file
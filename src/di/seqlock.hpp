@@ -0,0 +1,252 @@
+#pragma once
+
+#include <di/selection.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace di {
+
+namespace detail {
+
+/**
+ * @brief Widest unsigned word that evenly divides the size of V
+ */
+template <typename V>
+using seqlock_word_t = std::conditional_t<sizeof(V) % 8 == 0, std::uint64_t,
+    std::conditional_t<sizeof(V) % 4 == 0, std::uint32_t,
+        std::conditional_t<sizeof(V) % 2 == 0, std::uint16_t, std::uint8_t>>>;
+
+/**
+ * @brief A value of V guarded by a sequence counter
+ * 
+ * The value is stored as atomic words, so optimistic readers racing with a
+ * writer never read non-atomic memory; the sequence counter is odd while a
+ * write is in progress and tells readers to retry. Words are written with
+ * release and read with acquire instead of fences: a reader seeing any new
+ * word also sees the odd counter when it rechecks (plain moves on x86).
+ * 
+ * @tparam V The non-const, trivially copyable value type
+ */
+template <typename V>
+struct alignas(64) seqlock_state {
+    using word_t = seqlock_word_t<V>;
+    using raw_t  = std::array<word_t, sizeof(V) / sizeof(word_t)>;
+
+    std::atomic<std::uint64_t> seq = 0;
+    std::array<std::atomic<word_t>, sizeof(V) / sizeof(word_t)> words;
+
+    explicit seqlock_state(V const &value) noexcept {
+        auto const raw = to_raw(value);
+        for(std::size_t i = 0; i < raw.size(); ++i)
+            words[i].store(raw[i], std::memory_order_relaxed);
+    }
+
+    V load() const noexcept {
+        raw_t raw;
+        for(;;) {
+            auto const before = seq.load(std::memory_order_acquire);
+            if(before & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+            for(std::size_t i = 0; i < raw.size(); ++i)
+                raw[i] = words[i].load(std::memory_order_acquire);
+            if(seq.load(std::memory_order_relaxed) == before)
+                return from_raw(raw);
+        }
+    }
+
+    /**
+     * @brief Make the counter odd, waiting for other writers
+     * 
+     * @return std::uint64_t The (even) counter before the write
+     */
+    std::uint64_t lock() noexcept {
+        auto current = seq.load(std::memory_order_relaxed);
+        for(;;) {
+            if(current & 1) {
+                std::this_thread::yield();
+                current = seq.load(std::memory_order_relaxed);
+            } else if(seq.compare_exchange_weak(current, current + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return current;
+            }
+        }
+    }
+
+    void write(V const &value) noexcept {
+        auto const raw = to_raw(value);
+        for(std::size_t i = 0; i < raw.size(); ++i)
+            words[i].store(raw[i], std::memory_order_release);
+    }
+
+    void unlock(std::uint64_t before) noexcept {
+        seq.store(before + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Value as stored, for a writer holding the lock
+     */
+    V locked_value() const noexcept {
+        raw_t raw;
+        for(std::size_t i = 0; i < raw.size(); ++i)
+            raw[i] = words[i].load(std::memory_order_relaxed);
+        return from_raw(raw);
+    }
+
+private:
+    // memcpy rather than bit_cast: V may have padding, whose bytes are indeterminate
+    static raw_t to_raw(V const &value) noexcept {
+        raw_t raw;
+        std::memcpy(raw.data(), std::addressof(value), sizeof(V));
+        return raw;
+    }
+
+    static V from_raw(raw_t const &raw) noexcept {
+        alignas(V) std::byte bytes[sizeof(V)]; // V need not be default-constructible
+        std::memcpy(bytes, raw.data(), sizeof(V));
+        return *std::launder(reinterpret_cast<V *>(bytes));
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief A copy read from a SeqLockHolder, accessed like the service
+ * 
+ * @tparam V The value type
+ */
+template <typename V>
+class SeqLockSnapshot {
+    V value_;
+
+public:
+    explicit SeqLockSnapshot(V value) noexcept
+        : value_{ value } {}
+
+    V const *operator->() const noexcept {
+        return &value_;
+    }
+
+    V const &operator*() const noexcept {
+        return value_;
+    }
+};
+
+/**
+ * @brief A Selection holder type for small, mostly read, mutable state.
+ * 
+ * Keeps a trivially copyable value (rate limits, counter snapshots) under a
+ * sequence lock: readers copy it optimistically, without locks or writes to
+ * shared memory, and retry if a write overlapped; writers are serialized and
+ * never wait for readers.
+ * @code
+ *   auto services = SeqLockServices<Limits>{};
+ *   auto limits   = services.get<Limits>();
+ *   limits.update([](Limits &l) { l.per_second = 100; }); // writer
+ *   auto rate = limits->per_second;                        // reads a consistent copy
+ * @endcode
+ * 
+ * Requesting `const T` (or promoting to a SeqLockHolder<const T>) gives
+ * read-only access: load() but no store() or update().
+ * 
+ * @tparam T The (trivially copyable) service type
+ */
+template <typename T>
+class SeqLockHolder {
+    using value_t = std::remove_const_t<T>;
+    using data_t  = std::shared_ptr<detail::seqlock_state<value_t>>;
+
+    static_assert(std::is_trivially_copyable_v<value_t>, "SeqLockHolder requires a trivially copyable type");
+
+    data_t data_;
+
+    template <typename>
+    friend class SeqLockHolder;
+
+public:
+    /**
+     * @brief Hold an initial value.
+     */
+    explicit SeqLockHolder(value_t const &value)
+        : data_{ std::make_shared<detail::seqlock_state<value_t>>(value) } {}
+
+    /**
+     * @brief Promote a holder of non-const T to a read-only holder of const T.
+     * 
+     * @param other The holder to share the value with
+     */
+    template <typename U>
+    SeqLockHolder(SeqLockHolder<U> const &other) requires std::is_same_v<T, U const>
+        : data_{ other.data_ } {
+    }
+
+    /**
+     * @brief A consistent copy of the value.
+     */
+    value_t load() const noexcept {
+        return data_->load();
+    }
+
+    /**
+     * @brief Access a member of a consistent copy, e.g. `holder->limit`
+     */
+    SeqLockSnapshot<value_t> operator->() const noexcept {
+        return SeqLockSnapshot<value_t>{ load() };
+    }
+
+    value_t operator*() const noexcept {
+        return load();
+    }
+
+    /**
+     * @brief Replace the value.
+     */
+    void store(value_t const &value) noexcept requires(not std::is_const_v<T>) {
+        auto const before = data_->lock();
+        data_->write(value);
+        data_->unlock(before);
+    }
+
+    /**
+     * @brief Change the value in place, serialized with other writers.
+     * 
+     * @param fn Called with a `value_t&` copy of the current value; keep it short
+     */
+    template <typename Fn>
+    void update(Fn &&fn) requires(not std::is_const_v<T>) {
+        auto const before = data_->lock();
+        auto value        = data_->locked_value();
+        try {
+            fn(value);
+        } catch(...) {
+            data_->unlock(before);
+            throw;
+        }
+        data_->write(value);
+        data_->unlock(before);
+    }
+};
+
+/**
+ * @brief Selections of SeqLockHolder can default-construct their services
+ */
+template <>
+struct holder_traits<SeqLockHolder> {
+    static constexpr bool borrowing = false;
+
+    template <typename T>
+    static SeqLockHolder<T> make() {
+        return SeqLockHolder<T>{ std::remove_const_t<T>{} };
+    }
+};
+
+} // namespace di
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <di/selection.hpp>
+
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+namespace di {
+
+namespace detail {
+
+/**
+ * @brief A requirement for V{} to be a constant expression (V can be constinit)
+ * 
+ * Conservative: types whose value-initialization is not accepted as a constant
+ * template argument (e.g. ones holding a std::string) do not satisfy it.
+ */
+template <typename V>
+concept ConstantInitializable = std::default_initializable<V> && requires {
+    typename std::bool_constant<(static_cast<void>(V{}), true)>;
+};
+
+/**
+ * @brief The process-wide instance of V, initialized before any dynamic initialization runs
+ */
+template <typename V>
+requires ConstantInitializable<V>
+inline constinit V constant_instance{};
+
+/**
+ * @brief The process-wide instance of V
+ * 
+ * Constant-initializable types live in a constinit global, so this is just
+ * its address. Others are constructed on first access (thread-safe, one guard
+ * check per access), which still keeps them out of the static initialization order.
+ */
+template <typename V>
+V &static_instance() {
+    if constexpr(ConstantInitializable<V>) {
+        return constant_instance<V>;
+    } else {
+        static V instance{};
+        return instance;
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief A Selection holder type referring to a process-wide instance in static storage.
+ * 
+ * The holder itself is empty: it names the one instance of T that the
+ * whole process shares, so copying it touches no reference count and
+ * dereferencing it is the address of a global.
+ * @code
+ *   constinit auto services = StaticServices<Clock, const Config>{};
+ *   services.get<Clock>()->tick();
+ * @endcode
+ * 
+ * A selection of StaticHolder can be `constinit`. Types that can be
+ * constant-initialized (see detail::ConstantInitializable) are ready before
+ * any dynamic initializer runs; other types are constructed on first access.
+ * Either way the instance is destroyed at exit like any other global.
+ * 
+ * Every StaticHolder<T> and StaticHolder<const T> in the process refers to
+ * the same instance; a StaticHolder<T> converts to a StaticHolder<const T>.
+ * 
+ * Existing consumers keep their `services_t`: a StaticServices converts
+ * (with narrowing and const promotion) to Services, whose shared_ptrs then
+ * point at the static instances without owning them, or to Deps.
+ * 
+ * @tparam T
+ */
+template <typename T>
+class StaticHolder {
+    using value_t = std::remove_const_t<T>;
+
+public:
+    constexpr StaticHolder() noexcept = default;
+
+    /**
+     * @brief Promote a holder of non-const T to a holder of const T.
+     */
+    template <typename U>
+    constexpr StaticHolder(StaticHolder<U>) noexcept requires std::is_same_v<T, U const> {}
+
+    /**
+     * @brief Non-owning shared_ptr to the instance (no control block, no reference count).
+     */
+    template <typename U>
+    operator std::shared_ptr<U>() const requires std::convertible_to<T *, U *> {
+        return std::shared_ptr<U>{ std::shared_ptr<void>{}, get() };
+    }
+
+    /**
+     * @brief Reference to the instance (as held in Deps).
+     */
+    template <typename U>
+    operator std::reference_wrapper<U>() const requires std::convertible_to<T *, U *> {
+        return std::reference_wrapper<U>{ *get() };
+    }
+
+    T *get() const { return &detail::static_instance<value_t>(); }
+    T *operator->() const { return get(); }
+    T &operator*() const { return *get(); }
+};
+
+/**
+ * @brief Selections of StaticHolder can be constant-initialized and converted to Services or Deps
+ */
+template <>
+struct holder_traits<StaticHolder> {
+    static constexpr bool borrowing  = false;
+    static constexpr bool converting = true;
+
+    template <typename T>
+    static constexpr StaticHolder<T> make() noexcept {
+        return StaticHolder<T>{};
+    }
+};
+
+} // namespace di
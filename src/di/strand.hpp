@@ -0,0 +1,272 @@
+#pragma once
+
+#include <di/executor.hpp>
+#include <di/selection.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace di {
+
+namespace detail {
+
+/**
+ * @brief Node of a strand's queue, running one call on the service
+ */
+template <typename V>
+struct strand_op {
+    std::atomic<strand_op *> next = nullptr;
+
+    virtual ~strand_op() = default;
+    virtual void run(V &) noexcept {}
+};
+
+template <typename V, typename Fn>
+struct strand_fn_op : strand_op<V> {
+    std::optional<Fn> fn;
+
+    explicit strand_fn_op(Fn f)
+        : fn{ std::move(f) } {}
+
+    void run(V &value) noexcept override {
+        (*fn)(value);
+        fn.reset(); // the node lingers as the queue's stub until the next call runs
+    }
+};
+
+/**
+ * @brief A service and the calls queued for it
+ * 
+ * Producers push onto an intrusive multi-producer single-consumer queue
+ * (one exchange and one store). The producer that raises the pending
+ * count from zero becomes the consumer and drains the queue (or posts the
+ * draining to an executor); pending only drops to zero once the queue is
+ * empty, so at most one thread drains at a time.
+ * 
+ * @tparam V The non-const service type
+ */
+template <typename V>
+struct strand_state : std::enable_shared_from_this<strand_state<V>> {
+    V value;
+    std::function<void(std::function<void()>)> post_drain; /*! Empty: drain on the calling thread */
+
+    strand_op<V> stub;
+    alignas(64) std::atomic<strand_op<V> *> tail = &stub;
+    alignas(64) std::atomic<std::size_t> pending = 0;
+    strand_op<V> *head = &stub; /*! Consumer only; the last node run */
+
+    explicit strand_state(V v)
+        : value{ std::move(v) } {}
+
+    ~strand_state() {
+        // no holder is left, so nothing is queued anymore
+        if(head != &stub)
+            delete head;
+    }
+
+    void push(strand_op<V> *op) {
+        auto prev = tail.exchange(op, std::memory_order_acq_rel);
+        prev->next.store(op, std::memory_order_release);
+
+        if(pending.fetch_add(1, std::memory_order_acq_rel) == 0) {
+            if(post_drain)
+                post_drain([self = this->shared_from_this()] { self->drain(); });
+            else
+                drain();
+        }
+    }
+
+    void drain() noexcept {
+        do {
+            auto op = head->next.load(std::memory_order_acquire);
+            while(not op) { // a producer is between its exchange and its store
+                std::this_thread::yield();
+                op = head->next.load(std::memory_order_acquire);
+            }
+            if(head != &stub)
+                delete head;
+            head = op;
+            op->run(value);
+        } while(pending.fetch_sub(1, std::memory_order_acq_rel) != 1);
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief A Selection holder type serializing calls to a service that is not thread-safe.
+ * 
+ * Instead of locking, callers post closures taking the service; they are
+ * queued without locks and run one at a time, in posting order per thread,
+ * by whichever caller found the strand idle (or on an executor, see the
+ * constructor). Nobody waits for a mutex: a caller either queues its call
+ * and returns, or runs the queued calls itself.
+ * @code
+ *   auto services = StrandServices<Protocol>{ StrandHolder<Protocol>{ Protocol{} } };
+ *   auto protocol = services.get<Protocol>();
+ *   protocol.post([](Protocol &p) { p.on_packet(); });                 // fire and forget
+ *   auto state = protocol.call([](Protocol &p) { return p.state(); }); // std::future
+ *   auto again = co_await protocol.async([](Protocol &p) { return p.state(); });
+ * @endcode
+ * 
+ * Calls run on the draining thread, so they should be short; exceptions
+ * escaping a posted call terminate the program, those of call() and async()
+ * are delivered to the caller. Continuations of async() resume on the
+ * draining thread (or the executor).
+ * 
+ * A StrandHolder<T> converts to a StrandHolder<const T> sharing the same
+ * strand, whose calls receive a `T const&`.
+ * 
+ * @tparam T
+ */
+template <typename T>
+class StrandHolder {
+    using value_t = std::remove_const_t<T>;
+    using data_t  = std::shared_ptr<detail::strand_state<value_t>>;
+
+    data_t data_;
+
+    template <typename>
+    friend class StrandHolder;
+
+    template <typename Fn>
+    using result_t = std::invoke_result_t<Fn &, T &>;
+
+    template <typename Fn>
+    struct awaiter {
+        StrandHolder holder;
+        Fn fn;
+        std::conditional_t<std::is_void_v<result_t<Fn>>, bool, std::optional<result_t<Fn>>> result;
+        std::exception_ptr error;
+
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(std::coroutine_handle<> handle) {
+            // resumed inline, the coroutine may drop the last holder while this thread drains
+            auto const keep = holder;
+            auto post_drain = holder.data_->post_drain;
+            keep.post([this, handle, post_drain](T &value) {
+                try {
+                    if constexpr(std::is_void_v<result_t<Fn>>)
+                        fn(value);
+                    else
+                        result.emplace(fn(value));
+                } catch(...) {
+                    error = std::current_exception();
+                }
+                if(post_drain)
+                    post_drain([handle] { handle.resume(); });
+                else
+                    handle.resume();
+            });
+            // may have resumed already: this must not be touched anymore
+        }
+
+        result_t<Fn> await_resume() {
+            if(error)
+                std::rethrow_exception(error);
+            if constexpr(not std::is_void_v<result_t<Fn>>)
+                return std::move(*result);
+        }
+    };
+
+public:
+    /**
+     * @brief Own the service; queued calls run on the posting threads.
+     */
+    explicit StrandHolder(value_t value)
+        : data_{ std::make_shared<detail::strand_state<value_t>>(std::move(value)) } {}
+
+    /**
+     * @brief Own the service; queued calls run on an executor.
+     * 
+     * Posting never runs calls on the posting thread.
+     * 
+     * @param executor Runs the draining, e.g. a @ref ThreadPool (must outlive the holder)
+     */
+    template <Executor E>
+    StrandHolder(value_t value, E &executor)
+        : StrandHolder(std::move(value)) {
+        data_->post_drain = [&executor](std::function<void()> fn) { executor.post(std::move(fn)); };
+    }
+
+    /**
+     * @brief Promote a holder of non-const T to a holder of const T.
+     * 
+     * @param other The holder to share the strand with
+     */
+    template <typename U>
+    StrandHolder(StrandHolder<U> const &other) requires std::is_same_v<T, U const>
+        : data_{ other.data_ } {
+    }
+
+    /**
+     * @brief Queue a call without waiting for it.
+     * 
+     * @param fn Called with a `T&`; must not throw
+     */
+    template <typename Fn>
+    void post(Fn fn) const requires std::is_invocable_v<Fn &, T &> {
+        data_->push(new detail::strand_fn_op<value_t, Fn>(std::move(fn)));
+    }
+
+    /**
+     * @brief Queue a call and get its result as a future.
+     * 
+     * @param fn Called with a `T&`
+     * @return std::future Holds the result (or exception) of fn
+     */
+    template <typename Fn>
+    std::future<result_t<Fn>> call(Fn fn) const requires std::is_invocable_v<Fn &, T &> {
+        std::promise<result_t<Fn>> promise;
+        auto result = promise.get_future();
+        post([fn = std::move(fn), promise = std::move(promise)](T &value) mutable {
+            try {
+                if constexpr(std::is_void_v<result_t<Fn>>) {
+                    fn(value);
+                    promise.set_value();
+                } else {
+                    promise.set_value(fn(value));
+                }
+            } catch(...) {
+                promise.set_exception(std::current_exception());
+            }
+        });
+        return result;
+    }
+
+    /**
+     * @brief Queue a call when awaited, resuming with its result.
+     * 
+     * @param fn Called with a `T&`
+     * @return Awaitable producing the result of fn (or rethrowing its exception)
+     */
+    template <typename Fn>
+    awaiter<Fn> async(Fn fn) const requires std::is_invocable_v<Fn &, T &> {
+        return awaiter<Fn>{ *this, std::move(fn), {}, nullptr };
+    }
+};
+
+/**
+ * @brief Selections of StrandHolder can default-construct their services
+ */
+template <>
+struct holder_traits<StrandHolder> {
+    static constexpr bool borrowing = false;
+
+    template <typename T>
+    static StrandHolder<T> make() {
+        return StrandHolder<T>{ std::remove_const_t<T>{} };
+    }
+};
+
+} // namespace di
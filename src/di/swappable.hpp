@@ -0,0 +1,334 @@
+#pragma once
+
+#include <di/selection.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace di {
+
+namespace detail {
+
+/**
+ * @brief Read-side state of one thread, on a cache line of its own
+ * 
+ * active is 0 outside of read sections, otherwise the epoch observed when
+ * the outermost section started.
+ */
+struct alignas(64) rcu_reader {
+    std::atomic<std::uint64_t> active = 0;
+    std::uint32_t nesting             = 0;
+    std::atomic<bool> in_use          = true;
+};
+
+/**
+ * @brief The epoch and the readers shared by all swappable holders
+ * 
+ * Reader records are never freed; records of finished threads are reused.
+ */
+class rcu_domain {
+    std::mutex mtx_;
+    std::deque<rcu_reader> readers_; // stable addresses
+
+public:
+    std::atomic<std::uint64_t> epoch = 1;
+
+    static rcu_domain &instance() {
+        static rcu_domain domain;
+        return domain;
+    }
+
+    rcu_reader &acquire() {
+        std::lock_guard<std::mutex> g(mtx_);
+        for(auto &reader : readers_) {
+            auto expected = false;
+            if(reader.in_use.compare_exchange_strong(expected, true))
+                return reader;
+        }
+        return readers_.emplace_back();
+    }
+
+    /**
+     * @brief Whether no reader can still hold a pointer retired at epoch
+     */
+    bool quiescent(std::uint64_t retired_at) {
+        std::lock_guard<std::mutex> g(mtx_);
+        return std::all_of(readers_.begin(), readers_.end(), [retired_at](rcu_reader const &reader) {
+            auto const active = reader.active.load(std::memory_order_seq_cst);
+            return active == 0 or active >= retired_at;
+        });
+    }
+};
+
+/**
+ * @brief The calling thread's reader record, released when the thread exits
+ */
+inline rcu_reader &local_reader() {
+    struct handle {
+        rcu_reader &reader = rcu_domain::instance().acquire();
+        ~handle() { reader.in_use.store(false, std::memory_order_release); }
+    };
+    thread_local handle local;
+    return local.reader;
+}
+
+/**
+ * @brief State shared by all copies of a SwappableHolder (and its const promotions).
+ * 
+ * @tparam V The non-const service type
+ */
+template <typename V>
+struct swappable_state {
+    std::atomic<V const *> current;
+    std::mutex mtx; /*! Serializes writers, guards retired */
+    std::vector<std::pair<V const *, std::uint64_t>> retired;
+
+    explicit swappable_state(std::unique_ptr<V const> instance)
+        : current{ instance.release() } {}
+
+    ~swappable_state() {
+        // no holder is left, so neither is any reader of this state
+        delete current.load(std::memory_order_relaxed);
+        for(auto [instance, _] : retired)
+            delete instance;
+    }
+
+    void publish(std::unique_ptr<V const> instance) {
+        std::lock_guard<std::mutex> g(mtx);
+        replace(std::move(instance));
+    }
+
+    template <typename Fn>
+    void update(Fn &fn) {
+        std::lock_guard<std::mutex> g(mtx);
+        auto copy = std::make_unique<V>(*current.load(std::memory_order_relaxed));
+        fn(*copy);
+        replace(std::move(copy));
+    }
+
+    /**
+     * @brief Delete the retired instances no reader can hold anymore
+     * 
+     * @return Amount of instances still retired
+     */
+    std::size_t reclaim() {
+        std::lock_guard<std::mutex> g(mtx);
+        reclaim_locked();
+        return retired.size();
+    }
+
+private:
+    void replace(std::unique_ptr<V const> instance) {
+        auto old = current.exchange(instance.release(), std::memory_order_seq_cst);
+        // readers that may still see old entered before this epoch
+        auto const retired_at = rcu_domain::instance().epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+        retired.emplace_back(old, retired_at);
+        reclaim_locked();
+    }
+
+    void reclaim_locked() {
+        std::erase_if(retired, [](auto const &entry) {
+            if(not rcu_domain::instance().quiescent(entry.second))
+                return false;
+            delete entry.first;
+            return true;
+        });
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Access to the instance a SwappableHolder held when the guard was created
+ * 
+ * While any guard of a thread exists, the instances it can see are not
+ * deleted, even if a new one is published meanwhile. Guards are meant to be
+ * short-lived, must not leave their thread and must not outlive every
+ * copy of their holder.
+ * 
+ * @tparam T The service type (access is always const)
+ */
+template <typename T>
+class ReadGuard {
+    detail::rcu_reader *reader_;
+    T const *ptr_;
+
+public:
+    explicit ReadGuard(std::atomic<T const *> const &current)
+        : reader_{ &detail::local_reader() } {
+        // seq_cst orders the epoch before the pointer load: a reader seeing the
+        // epoch of a swap also sees the instance it published
+        if(reader_->nesting++ == 0)
+            reader_->active.store(detail::rcu_domain::instance().epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+        ptr_ = current.load(std::memory_order_seq_cst);
+    }
+
+    ReadGuard(ReadGuard const &) = delete;
+    ReadGuard &operator=(ReadGuard const &) = delete;
+
+    ~ReadGuard() {
+        if(--reader_->nesting == 0)
+            reader_->active.store(0, std::memory_order_release);
+    }
+
+    T const *get() const noexcept {
+        return ptr_;
+    }
+
+    T const *operator->() const noexcept {
+        return ptr_;
+    }
+
+    T const &operator*() const noexcept {
+        return *ptr_;
+    }
+};
+
+/**
+ * @brief A Selection holder type whose instance can be replaced at runtime.
+ * 
+ * Meant for configs and routing tables that are reloaded while being read.
+ * A writer publishes a new instance atomically; reading through a holder
+ * takes a consistent snapshot without locks or reference counting (two
+ * stores to a thread-local cache line and one load), and every instance is
+ * deleted only once no reader can hold it anymore (epoch-based reclamation,
+ * as in RCU). Getting the holder from a selection copies its shared state,
+ * so hot paths keep a holder and read through it:
+ * @code
+ *   auto services = SwappableServices<const Routes>{ SwappableHolder<const Routes>{ load_routes() } };
+ *   auto routes   = services.get<Routes>(); // once, e.g. in a constructor
+ *   routes->find(path);                     // one snapshot for the expression
+ *   {
+ *       auto snapshot = routes.read();      // one snapshot for the scope
+ *       snapshot->find(a);
+ *       snapshot->find(b);
+ *   }
+ *   routes.publish(load_routes());          // from the reloading thread
+ * @endcode
+ * 
+ * Instances are immutable snapshots: reads always give const access, and
+ * changes go through publish() or update(). Writers are serialized. Readers
+ * never reclaim: an instance replaced while being read is deleted by the
+ * first publish(), update() or reclaim() after its readers left their read
+ * sections, or with the last holder. Without further writes or reclaim()
+ * calls, each instance replaced during a read section can stay retired
+ * indefinitely, so writers that publish rarely can call reclaim() (e.g.
+ * from a timer) to bound that.
+ * 
+ * A SwappableHolder<T> converts to a SwappableHolder<const T> sharing the same state.
+ * 
+ * @tparam T
+ */
+template <typename T>
+class SwappableHolder {
+    using value_t = std::remove_const_t<T>;
+    using data_t  = std::shared_ptr<detail::swappable_state<value_t>>;
+
+    data_t data_;
+
+    template <typename>
+    friend class SwappableHolder;
+
+public:
+    /**
+     * @brief Hold an initial instance.
+     * 
+     * @param instance Must not be null
+     */
+    explicit SwappableHolder(std::unique_ptr<value_t> instance)
+        : data_{ std::make_shared<detail::swappable_state<value_t>>(std::move(instance)) } {}
+
+    /**
+     * @brief Hold an initial instance, moved or copied from value.
+     */
+    explicit SwappableHolder(value_t value)
+        : SwappableHolder(std::make_unique<value_t>(std::move(value))) {}
+
+    /**
+     * @brief Promote a holder of non-const T to a holder of const T.
+     * 
+     * @param other The holder to share state with
+     */
+    template <typename U>
+    SwappableHolder(SwappableHolder<U> const &other) requires std::is_same_v<T, U const>
+        : data_{ other.data_ } {
+    }
+
+    /**
+     * @brief Snapshot of the current instance, valid for the lifetime of the guard
+     */
+    ReadGuard<value_t> read() const {
+        return ReadGuard<value_t>{ data_->current };
+    }
+
+    /**
+     * @brief Access the current instance for one expression
+     */
+    ReadGuard<value_t> operator->() const {
+        return read();
+    }
+
+    /**
+     * @brief Replace the instance; readers see either the old or the new one.
+     * 
+     * @param instance Must not be null
+     */
+    void publish(std::unique_ptr<value_t> instance) {
+        data_->publish(std::move(instance));
+    }
+
+    void publish(value_t value) {
+        publish(std::make_unique<value_t>(std::move(value)));
+    }
+
+    /**
+     * @brief Publish a changed copy of the current instance (read-copy-update).
+     * 
+     * @param fn Called with a `value_t&` copy to change
+     */
+    template <typename Fn>
+    void update(Fn &&fn) requires std::is_copy_constructible_v<value_t> {
+        data_->update(fn);
+    }
+
+    /**
+     * @brief Delete the replaced instances no reader can hold anymore.
+     * 
+     * Never blocks on readers; instances still read stay retired.
+     * 
+     * @return Amount of replaced instances not reclaimed yet
+     */
+    std::size_t reclaim() {
+        return data_->reclaim();
+    }
+
+    /**
+     * @brief Amount of replaced instances not reclaimed yet.
+     */
+    std::size_t retired() const {
+        std::lock_guard<std::mutex> g(data_->mtx);
+        return data_->retired.size();
+    }
+};
+
+/**
+ * @brief Selections of SwappableHolder can default-construct their services
+ */
+template <>
+struct holder_traits<SwappableHolder> {
+    static constexpr bool borrowing = false;
+
+    template <typename T>
+    static SwappableHolder<T> make() {
+        return SwappableHolder<T>{ std::make_unique<std::remove_const_t<T>>() };
+    }
+};
+
+} // namespace di
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <di/executor.hpp>
+
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace di {
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+struct task_promise_base {
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+    std::exception_ptr error;
+
+    struct final_awaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            return handle.promise().continuation;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    final_awaiter final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception() noexcept {
+        error = std::current_exception();
+    }
+};
+
+template <typename T>
+struct task_promise : task_promise_base {
+    std::optional<T> value;
+
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U &&result) {
+        value.emplace(std::forward<U>(result));
+    }
+
+    T result() {
+        if(error)
+            std::rethrow_exception(error);
+        return std::move(*value);
+    }
+};
+
+template <>
+struct task_promise<void> : task_promise_base {
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+
+    void result() const {
+        if(error)
+            std::rethrow_exception(error);
+    }
+};
+
+/**
+ * @brief A coroutine that starts immediately and destroys itself when done
+ */
+struct detached {
+    struct promise_type {
+        detached get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+} // namespace detail
+
+/**
+ * @brief A lazily started coroutine producing a T
+ * 
+ * The coroutine starts once the task is awaited and resumes the
+ * awaiting coroutine when it finishes. A task can be awaited only once.
+ * 
+ * @tparam T The result type
+ */
+template <typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::task_promise<T>;
+
+private:
+    using handle_t = std::coroutine_handle<promise_type>;
+    handle_t handle_;
+
+public:
+    explicit Task(handle_t handle) noexcept
+        : handle_{ handle } {}
+
+    Task(Task &&other) noexcept
+        : handle_{ std::exchange(other.handle_, nullptr) } {}
+
+    Task &operator=(Task &&other) noexcept {
+        if(this != &other) {
+            if(handle_)
+                handle_.destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    ~Task() {
+        if(handle_)
+            handle_.destroy();
+    }
+
+    auto operator co_await() && noexcept {
+        struct awaiter {
+            handle_t handle;
+
+            bool await_ready() const noexcept { return false; }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept {
+                handle.promise().continuation = continuation;
+                return handle;
+            }
+
+            T await_resume() {
+                return handle.promise().result();
+            }
+        };
+        return awaiter{ handle_ };
+    }
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> task_promise<T>::get_return_object() noexcept {
+    return Task<T>{ std::coroutine_handle<task_promise<T>>::from_promise(*this) };
+}
+
+inline Task<void> task_promise<void>::get_return_object() noexcept {
+    return Task<void>{ std::coroutine_handle<task_promise<void>>::from_promise(*this) };
+}
+
+} // namespace detail
+
+/**
+ * @brief Resume the awaiting coroutine on the executor
+ * 
+ * @code
+ *   co_await schedule(pool); // continues on one of the pool's threads
+ * @endcode
+ * 
+ * @param executor The executor to continue on
+ */
+template <Executor E>
+auto schedule(E &executor) noexcept {
+    struct awaiter {
+        E &executor;
+
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(std::coroutine_handle<> handle) {
+            executor.post([handle] { handle.resume(); });
+        }
+
+        void await_resume() const noexcept {}
+    };
+    return awaiter{ executor };
+}
+
+/**
+ * @brief Run a task to completion on the executor without waiting for it
+ * 
+ * An exception escaping the task terminates the program.
+ * 
+ * @param executor The executor to start the task on
+ * @param task The task
+ */
+template <Executor E>
+void spawn(E &executor, Task<void> task) {
+    [](E &executor, Task<void> task) -> detail::detached {
+        co_await schedule(executor);
+        co_await std::move(task);
+    }(executor, std::move(task));
+}
+
+/**
+ * @brief Block the calling thread until the task completes
+ * 
+ * Meant for the edges of a program (main, tests); never call it on
+ * a thread the task relies on.
+ * 
+ * @param task The task
+ * @return T The result of the task (or rethrows its exception)
+ */
+template <typename T>
+T sync_wait(Task<T> task) {
+    std::promise<T> promise;
+    auto result = promise.get_future();
+
+    [](Task<T> task, std::promise<T> promise) -> detail::detached {
+        try {
+            if constexpr(std::is_void_v<T>) {
+                co_await std::move(task);
+                promise.set_value();
+            } else {
+                promise.set_value(co_await std::move(task));
+            }
+        } catch(...) {
+            promise.set_exception(std::current_exception());
+        }
+    }(std::move(task), std::move(promise));
+
+    return result.get();
+}
+
+} // namespace di
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <di/lazy.hpp>
+#include <di/selection.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace di {
+
+namespace detail {
+
+/**
+ * @brief Per-thread lookup entry of a thread-local state
+ * 
+ * Ids are never reused, so entries of destroyed states are never matched;
+ * they are only pruned (via owner) when the thread adds a new entry.
+ */
+struct thread_local_slot {
+    std::uint64_t id;
+    void *instance;
+    std::weak_ptr<void const> owner;
+};
+
+inline std::vector<thread_local_slot> &thread_local_slots() {
+    thread_local std::vector<thread_local_slot> slots;
+    return slots;
+}
+
+inline std::uint64_t next_thread_local_id() noexcept {
+    static std::atomic<std::uint64_t> next = 1;
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief State shared by all copies of a ThreadLocalHolder (and its const promotions).
+ * 
+ * Owns the instances of all threads, so they outlive the threads that
+ * created them and can still be merged afterwards.
+ * 
+ * @tparam V The non-const service type
+ */
+template <typename V>
+struct thread_local_state : std::enable_shared_from_this<thread_local_state<V>> {
+    std::uint64_t const id = next_thread_local_id();
+    std::mutex mtx; /*! Guards instances and the factory */
+    std::vector<std::shared_ptr<V>> instances;
+
+    virtual ~thread_local_state() = default;
+    virtual std::shared_ptr<V> create() = 0; /*! Runs the factory */
+
+    /**
+     * @brief The instance of the calling thread, created on first use
+     */
+    V *local() {
+        auto &slots = thread_local_slots();
+        for(auto const &slot : slots)
+            if(slot.id == id)
+                return static_cast<V *>(slot.instance);
+        return add(slots);
+    }
+
+private:
+    V *add(std::vector<thread_local_slot> &slots) {
+        V *instance = nullptr;
+        {
+            std::lock_guard<std::mutex> g(mtx);
+            instances.push_back(create());
+            instance = instances.back().get();
+        }
+
+        std::erase_if(slots, [](auto const &slot) { return slot.owner.expired(); });
+        slots.push_back(thread_local_slot{ id, instance, this->weak_from_this() });
+        return instance;
+    }
+};
+
+/**
+ * @brief Thread-local state storing the factory by its concrete type
+ * 
+ * @tparam V The non-const service type
+ * @tparam Fn The factory type
+ */
+template <typename V, typename Fn>
+struct factory_thread_local_state : thread_local_state<V> {
+    Fn factory;
+
+    explicit factory_thread_local_state(Fn fn)
+        : factory{ std::move(fn) } {}
+
+    std::shared_ptr<V> create() override {
+        if constexpr(ValueFactoryFor<Fn, V>)
+            return std::make_shared<V>(factory());
+        else
+            return std::const_pointer_cast<V>(std::shared_ptr<V const>(factory()));
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief A Selection holder type keeping one instance per thread.
+ * 
+ * Meant for mutable services that are cheap to replicate but slow to share
+ * (random generators, scratch allocators, metric accumulators). Each thread
+ * gets its own instance, created by the factory on its first access. Later
+ * accesses find it in a small thread-local table, without locks or
+ * reference counting:
+ * @code
+ *   auto services = ThreadLocalServices<Counter>{ [] { return Counter{}; } };
+ *   services.get<Counter>()->hits++; // the calling thread's counter
+ * @endcode
+ * 
+ * The instances are owned by the holder (shared by its copies), outlive the
+ * threads that created them and can be merged with for_each(), e.g. once
+ * the workers are joined. The factory runs under a lock and needs not be
+ * thread-safe.
+ * 
+ * A ThreadLocalHolder<T> converts to a ThreadLocalHolder<const T> sharing the same instances.
+ * 
+ * @tparam T
+ */
+template <typename T>
+class ThreadLocalHolder {
+    using value_t = std::remove_const_t<T>;
+    using data_t  = std::shared_ptr<detail::thread_local_state<value_t>>;
+
+    data_t data_;
+
+    template <typename>
+    friend class ThreadLocalHolder;
+
+public:
+    /**
+     * @brief Store a factory for the per-thread instances.
+     * 
+     * @tparam Fn Any compatible function or lambda
+     * @param factory Expected to return `shared_ptr<T>` or T by value
+     */
+    template <typename Fn>
+    ThreadLocalHolder(Fn factory) requires SharedFactoryFor<Fn, T> or ValueFactoryFor<Fn, T>
+        : data_{ std::make_shared<detail::factory_thread_local_state<value_t, Fn>>(std::move(factory)) } {
+    }
+
+    /**
+     * @brief Promote a holder of non-const T to a holder of const T.
+     * 
+     * @param other The holder to share instances with
+     */
+    template <typename U>
+    ThreadLocalHolder(ThreadLocalHolder<U> const &other) requires std::is_same_v<T, U const>
+        : data_{ other.data_ } {
+    }
+
+    /**
+     * @brief Get the instance of the calling thread.
+     * 
+     * @return T* Valid as long as any copy of the holder exists
+     */
+    T *get() const {
+        return data_->local();
+    }
+
+    T *operator->() const {
+        return get();
+    }
+
+    T &operator*() const {
+        return *get();
+    }
+
+    /**
+     * @brief Visit the instances of all threads (that accessed the holder so far).
+     * 
+     * Instances are visited under a lock, so no new instance can be created
+     * meanwhile; synchronizing with threads still using theirs is up to the caller.
+     * 
+     * @param fn Called with a `T&` for each instance
+     */
+    template <typename Fn>
+    void for_each(Fn &&fn) const {
+        std::lock_guard<std::mutex> g(data_->mtx);
+        for(auto const &instance : data_->instances)
+            fn(static_cast<T &>(*instance));
+    }
+
+    /**
+     * @brief Amount of per-thread instances created so far.
+     */
+    std::size_t instances() const {
+        std::lock_guard<std::mutex> g(data_->mtx);
+        return data_->instances.size();
+    }
+};
+
+} // namespace di
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace di {
+
+namespace detail {
+
+/**
+ * @brief Small dense index of the calling thread, e.g. to pick a shard
+ */
+inline std::size_t thread_slot() noexcept {
+    static std::atomic<std::size_t> next = 0;
+    thread_local std::size_t const slot  = next.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+} // namespace detail
+
+} // namespace di
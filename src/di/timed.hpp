@@ -0,0 +1,382 @@
+#pragma once
+
+#include <di/selection.hpp>
+#include <di/util.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace di {
+
+/**
+ * @brief Distribution of call durations, in power-of-two buckets of nanoseconds
+ * 
+ * Bucket i counts durations in [2^(i-1), 2^i) ns; bucket 0 counts calls
+ * that took less than a nanosecond.
+ */
+struct LatencyHistogram {
+    static constexpr std::size_t bucket_count = 65;
+
+    std::array<std::uint64_t, bucket_count> buckets{};
+    std::uint64_t calls    = 0; /*! Sampled calls */
+    std::uint64_t total_ns = 0;
+    std::uint64_t max_ns   = 0;
+
+    static constexpr std::size_t bucket_of(std::uint64_t ns) noexcept {
+        return static_cast<std::size_t>(std::bit_width(ns));
+    }
+
+    void merge(LatencyHistogram const &other) noexcept {
+        for(std::size_t i = 0; i < bucket_count; ++i)
+            buckets[i] += other.buckets[i];
+        calls += other.calls;
+        total_ns += other.total_ns;
+        max_ns = std::max(max_ns, other.max_ns);
+    }
+
+    double mean_ns() const noexcept {
+        return calls ? static_cast<double>(total_ns) / static_cast<double>(calls) : 0.0;
+    }
+
+    /**
+     * @brief Upper bound of the bucket holding the q-quantile (e.g. 0.99)
+     * 
+     * @param q In [0, 1]
+     * @return std::uint64_t Nanoseconds, at most twice the actual quantile
+     */
+    std::uint64_t percentile(double q) const noexcept {
+        auto const rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(q * static_cast<double>(calls) + 0.5));
+        std::uint64_t seen = 0;
+        for(std::size_t i = 0; i < bucket_count; ++i) {
+            seen += buckets[i];
+            if(seen >= rank)
+                return i == 0 ? 0 : std::min(i == 64 ? max_ns : (std::uint64_t{ 1 } << i) - 1, max_ns);
+        }
+        return max_ns;
+    }
+};
+
+namespace detail {
+
+/**
+ * @brief Histogram written by a single thread and read by snapshots
+ * 
+ * The owner thread updates with plain load/store pairs (no locked
+ * instructions); readers may see a call counted in some fields only.
+ * Once its thread exits, the histogram is handed to the next thread
+ * timing the same type, keeping the counts.
+ */
+struct thread_latency {
+    std::string_view type;
+    void const *key;
+    std::atomic<bool> in_use = true;
+    std::array<std::atomic<std::uint64_t>, LatencyHistogram::bucket_count> buckets{};
+    std::atomic<std::uint64_t> calls    = 0;
+    std::atomic<std::uint64_t> total_ns = 0;
+    std::atomic<std::uint64_t> max_ns   = 0;
+
+    thread_latency(std::string_view name, void const *type_key)
+        : type{ name }
+        , key{ type_key } {}
+
+    static void bump(std::atomic<std::uint64_t> &counter, std::uint64_t by) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    void record(std::uint64_t ns) noexcept {
+        bump(buckets[LatencyHistogram::bucket_of(ns)], 1);
+        bump(calls, 1);
+        bump(total_ns, ns);
+        if(ns > max_ns.load(std::memory_order_relaxed))
+            max_ns.store(ns, std::memory_order_relaxed);
+    }
+
+    void add_to(LatencyHistogram &histogram) const noexcept {
+        LatencyHistogram local;
+        for(std::size_t i = 0; i < LatencyHistogram::bucket_count; ++i)
+            local.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+        local.calls    = calls.load(std::memory_order_relaxed);
+        local.total_ns = total_ns.load(std::memory_order_relaxed);
+        local.max_ns   = max_ns.load(std::memory_order_relaxed);
+        histogram.merge(local);
+    }
+
+    void reset() noexcept {
+        for(auto &bucket : buckets)
+            bucket.store(0, std::memory_order_relaxed);
+        calls.store(0, std::memory_order_relaxed);
+        total_ns.store(0, std::memory_order_relaxed);
+        max_ns.store(0, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief Every per-thread histogram of every timed service type
+ * 
+ * Histograms are never freed, so calls of finished threads stay visible;
+ * new threads reuse those of finished ones, so there are at most as many
+ * per type as threads timing it at once.
+ */
+class latency_registry {
+    std::mutex mtx_;
+    std::deque<thread_latency> histograms_; // stable addresses
+
+public:
+    std::atomic<std::uint32_t> sample_every = 1;
+
+    static latency_registry &instance() {
+        static latency_registry registry;
+        return registry;
+    }
+
+    thread_latency &add(std::string_view type, void const *key) {
+        std::lock_guard<std::mutex> g(mtx_);
+        for(auto &histogram : histograms_) {
+            auto expected = false;
+            if(histogram.key == key and histogram.in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                return histogram;
+        }
+        return histograms_.emplace_back(type, key);
+    }
+
+    template <typename Fn>
+    void for_each(Fn &&fn) {
+        std::lock_guard<std::mutex> g(mtx_);
+        for(auto &histogram : histograms_)
+            fn(histogram);
+    }
+};
+
+template <typename V>
+inline constexpr char latency_key = 0;
+
+/**
+ * @brief Hands a thread's histogram back to the registry when the thread exits
+ */
+struct latency_lease {
+    thread_latency &histogram;
+
+    ~latency_lease() {
+        histogram.in_use.store(false, std::memory_order_release);
+    }
+};
+
+/**
+ * @brief The calling thread's histogram for V, registered on first use
+ */
+template <typename V>
+thread_latency &local_latency() {
+    thread_local latency_lease lease{ latency_registry::instance().add(type_name<V>(), &latency_key<V>) };
+    return lease.histogram;
+}
+
+/**
+ * @brief Whether to time the current call, honoring the sampling rate
+ */
+inline bool sample_call() noexcept {
+    thread_local std::uint32_t countdown = 1;
+    auto const every = latency_registry::instance().sample_every.load(std::memory_order_relaxed);
+    if(every == 0)
+        return false;
+    if(--countdown != 0 and countdown < every) // a larger countdown means the interval was just shortened
+        return false;
+    countdown = every;
+    return true;
+}
+
+} // namespace detail
+
+/**
+ * @brief Time one in `every` calls through TimedHolders (0 disables timing, default 1)
+ * 
+ * @param every Sampling interval, per thread
+ */
+inline void set_latency_sampling(std::uint32_t every) noexcept {
+    detail::latency_registry::instance().sample_every.store(every, std::memory_order_relaxed);
+}
+
+inline std::uint32_t latency_sampling() noexcept {
+    return detail::latency_registry::instance().sample_every.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Merge the histograms of all threads for service type T
+ * 
+ * @tparam T The service type (const or not)
+ */
+template <typename T>
+LatencyHistogram latency_snapshot() {
+    LatencyHistogram histogram;
+    detail::latency_registry::instance().for_each([&](detail::thread_latency const &local) {
+        if(local.key == &detail::latency_key<std::remove_const_t<T>>)
+            local.add_to(histogram);
+    });
+    return histogram;
+}
+
+/**
+ * @brief Merged histograms of every timed service type
+ * 
+ * @return Pairs of type name and histogram, in order of first use
+ */
+inline std::vector<std::pair<std::string_view, LatencyHistogram>> latency_snapshots() {
+    std::vector<std::pair<std::string_view, LatencyHistogram>> result;
+    detail::latency_registry::instance().for_each([&](detail::thread_latency const &local) {
+        auto it = std::find_if(result.begin(), result.end(), [&](auto const &entry) { return entry.first == local.type; });
+        if(it == result.end())
+            it = result.insert(result.end(), { local.type, LatencyHistogram{} });
+        local.add_to(it->second);
+    });
+    return result;
+}
+
+/**
+ * @brief Zero all histograms (e.g. after each snapshot to report intervals)
+ * 
+ * Calls recorded concurrently may be partially kept.
+ */
+inline void reset_latency() {
+    detail::latency_registry::instance().for_each([](detail::thread_latency &local) { local.reset(); });
+}
+
+/**
+ * @brief Proxy returned by TimedHolder::operator->, timing one member call
+ * 
+ * Lives until the end of the full expression, so `holder->call()` is timed
+ * from before the call until it returns.
+ * 
+ * @tparam T The service type
+ */
+template <typename T>
+class TimedCall {
+    using clock = std::chrono::steady_clock;
+
+    T *ptr_;
+    detail::thread_latency *histogram_ = nullptr; /*! Set if this call is sampled */
+    clock::time_point start_;
+
+public:
+    /**
+     * @brief Start timing if the call is sampled
+     * 
+     * The thread's histogram is registered here on first use, so the
+     * destructor only records. A failed registration leaves the call untimed.
+     */
+    explicit TimedCall(T *ptr) noexcept
+        : ptr_{ ptr } {
+        if(not detail::sample_call())
+            return;
+        try {
+            histogram_ = &detail::local_latency<std::remove_const_t<T>>();
+        } catch(...) {
+            return;
+        }
+        start_ = clock::now();
+    }
+
+    TimedCall(TimedCall const &) = delete;
+    TimedCall &operator=(TimedCall const &) = delete;
+
+    ~TimedCall() {
+        if(histogram_) {
+            auto const ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start_).count();
+            histogram_->record(static_cast<std::uint64_t>(ns));
+        }
+    }
+
+    T *operator->() const noexcept {
+        return ptr_;
+    }
+};
+
+/**
+ * @brief A Selection holder type timing every member call made through it.
+ * 
+ * Owns (or, built from a reference, refers to) the service like a
+ * shared_ptr, but `holder->call()` goes through a @ref TimedCall that records
+ * the call duration into a per-thread histogram of T. Swapping an alias is
+ * enough to instrument all services of a selection:
+ * @code
+ *   using services_t = TimedServices<A, B>; // was Services<A, B>
+ *   services_t services;                    // default-constructs A and B
+ *   services.get<A>()->work();              // timed
+ *   auto histogram = latency_snapshot<A>();
+ * @endcode
+ * 
+ * Recording needs no locks nor locked instructions; see
+ * @ref set_latency_sampling to time only a fraction of the calls.
+ * `get()` and `operator*` access the service without timing.
+ * 
+ * A TimedHolder<T> converts to a TimedHolder<const T> sharing the same service.
+ * 
+ * @tparam T
+ */
+template <typename T>
+class TimedHolder {
+    std::shared_ptr<T> ptr_;
+
+    template <typename>
+    friend class TimedHolder;
+
+public:
+    /**
+     * @brief Own a shared instance.
+     */
+    TimedHolder(std::shared_ptr<T> ptr) noexcept
+        : ptr_{ std::move(ptr) } {}
+
+    /**
+     * @brief Refer to an instance owned elsewhere (as in Deps).
+     */
+    TimedHolder(std::reference_wrapper<T> ref) noexcept
+        : ptr_{ std::shared_ptr<void>{}, std::addressof(ref.get()) } {}
+
+    /**
+     * @brief Promote a holder of non-const T to a holder of const T.
+     * 
+     * @param other The holder to share the service with
+     */
+    template <typename U>
+    TimedHolder(TimedHolder<U> const &other) noexcept requires std::is_same_v<T, U const>
+        : ptr_{ other.ptr_ } {
+    }
+
+    TimedCall<T> operator->() const noexcept {
+        return TimedCall<T>{ ptr_.get() };
+    }
+
+    T *get() const noexcept {
+        return ptr_.get();
+    }
+
+    T &operator*() const noexcept {
+        return *ptr_;
+    }
+};
+
+/**
+ * @brief Selections of TimedHolder can default-construct their services
+ */
+template <>
+struct holder_traits<TimedHolder> {
+    static constexpr bool borrowing = false;
+
+    template <typename T>
+    static TimedHolder<T> make() {
+        return TimedHolder<T>{ std::make_shared<T>() };
+    }
+};
+
+} // namespace di
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <di/thread_slot.hpp>
+#include <di/trace_hook.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace di {
+
+/**
+ * @brief One begin ('B') or end ('E') event of a traced construction
+ */
+struct TraceEvent {
+    std::string_view name;     /*! Service type (or phase) name, with static storage */
+    std::string_view category; /*! "services", "lazy" or "injector" */
+    char phase;                /*! 'B' or 'E' */
+    std::uint64_t ts_ns;       /*! Time since the recorder was created */
+    std::size_t tid;           /*! Dense index of the constructing thread */
+};
+
+/**
+ * @brief Collects the construction timeline of services, e.g. during startup
+ * 
+ * While installed (see @ref ScopedTrace), every default construction of a
+ * Selection, every LazyHolder factory and every service built by an Injector
+ * records a begin and an end event with the service type and the calling
+ * thread. A construction that constructs other services (a factory resolving
+ * another lazy service) encloses their events, so viewers show them as
+ * children.
+ * @code
+ *   TraceRecorder recorder;
+ *   {
+ *       ScopedTrace tracing{ recorder };
+ *       auto services = Injector<Watchdog>::build();
+ *   }
+ *   recorder.save("startup.json"); // open in chrome://tracing or ui.perfetto.dev
+ * @endcode
+ */
+class TraceRecorder final : public detail::trace_sink {
+    using clock = std::chrono::steady_clock;
+
+    clock::time_point const start_ = clock::now();
+    mutable std::mutex mtx_;
+    std::vector<TraceEvent> events_;
+
+    static void write_string(std::ostream &out, std::string_view str) {
+        out << '"';
+        for(auto c : str) {
+            if(c == '"' or c == '\\')
+                out << '\\';
+            out << c;
+        }
+        out << '"';
+    }
+
+public:
+    void record(std::string_view name, std::string_view category, char phase) override {
+        auto const ts = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start_).count());
+        auto const tid = detail::thread_slot();
+
+        std::lock_guard<std::mutex> g(mtx_);
+        events_.push_back(TraceEvent{ name, category, phase, ts, tid });
+    }
+
+    /**
+     * @brief Copy of the events recorded so far, in recording order
+     */
+    std::vector<TraceEvent> events() const {
+        std::lock_guard<std::mutex> g(mtx_);
+        return events_;
+    }
+
+    /**
+     * @brief Write the events in the Chrome trace event format (JSON object)
+     * 
+     * @param out Receives the trace
+     */
+    void write(std::ostream &out) const {
+        out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+        auto first = true;
+        for(auto const &event : events()) {
+            out << (first ? "\n  {" : ",\n  {");
+            first = false;
+
+            out << "\"name\": ";
+            write_string(out, event.name);
+            out << ", \"cat\": ";
+            write_string(out, event.category);
+            out << ", \"ph\": \"" << event.phase << '"'
+                << ", \"ts\": " << event.ts_ns / 1000 << '.' << std::to_string(1000 + event.ts_ns % 1000).substr(1)
+                << ", \"pid\": 1, \"tid\": " << event.tid << '}';
+        }
+        out << "\n]}\n";
+    }
+
+    /**
+     * @brief Write the trace to a file
+     * 
+     * @param path File to (over)write
+     * @return true if the file was written
+     */
+    bool save(std::string const &path) const {
+        std::ofstream out(path);
+        write(out);
+        return static_cast<bool>(out);
+    }
+};
+
+/**
+ * @brief Installs a recorder for its lifetime
+ * 
+ * Only one recorder is active at a time. Constructions still running on
+ * other threads when the scope ends must have finished before the recorder
+ * is destroyed.
+ */
+class ScopedTrace {
+    detail::trace_sink *previous_;
+
+public:
+    explicit ScopedTrace(TraceRecorder &recorder) noexcept
+        : previous_{ detail::active_trace_recorder().exchange(&recorder, std::memory_order_acq_rel) } {}
+
+    ScopedTrace(ScopedTrace const &) = delete;
+    ScopedTrace &operator=(ScopedTrace const &) = delete;
+
+    ~ScopedTrace() {
+        detail::active_trace_recorder().store(previous_, std::memory_order_release);
+    }
+};
+
+} // namespace di
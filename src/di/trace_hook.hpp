@@ -0,0 +1,71 @@
+#pragma once
+
+#include <di/util.hpp>
+
+#include <atomic>
+#include <string_view>
+#include <type_traits>
+
+namespace di {
+
+namespace detail {
+
+/**
+ * @brief Receives the begin and end events of traced constructions (see TraceRecorder)
+ */
+class trace_sink {
+public:
+    virtual void record(std::string_view name, std::string_view category, char phase) = 0;
+
+protected:
+    ~trace_sink() = default;
+};
+
+inline std::atomic<trace_sink *> &active_trace_recorder() noexcept {
+    static std::atomic<trace_sink *> recorder = nullptr;
+    return recorder;
+}
+
+} // namespace detail
+
+/**
+ * @brief Records a begin event on construction and the matching end event on destruction
+ * 
+ * Does nothing (but one atomic load) while no recorder is installed.
+ */
+class TraceSpan {
+    detail::trace_sink *recorder_;
+    std::string_view name_;
+    std::string_view category_;
+
+public:
+    TraceSpan(std::string_view name, std::string_view category)
+        : recorder_{ detail::active_trace_recorder().load(std::memory_order_acquire) }
+        , name_{ name }
+        , category_{ category } {
+        if(recorder_)
+            recorder_->record(name_, category_, 'B');
+    }
+
+    TraceSpan(TraceSpan const &) = delete;
+    TraceSpan &operator=(TraceSpan const &) = delete;
+
+    ~TraceSpan() {
+        if(recorder_)
+            recorder_->record(name_, category_, 'E');
+    }
+};
+
+namespace detail {
+
+/**
+ * @brief Span named after the service type T
+ */
+template <typename T>
+TraceSpan trace_construction(std::string_view category) {
+    return TraceSpan{ type_name<std::remove_const_t<T>>(), category };
+}
+
+} // namespace detail
+
+} // namespace di
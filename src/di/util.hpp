@@ -1,6 +1,10 @@
 #pragma once
 
+#include <cstddef>
+#include <source_location>
+#include <string_view>
 #include <type_traits>
+#include <utility>
 
 namespace di {
 
@@ -26,14 +30,179 @@ struct type_match_count {
     static constexpr std::size_t value = (std::is_same_v<T, Types> + ...);
 };
 
+namespace detail {
+
+template <typename T, std::size_t I>
+struct index_entry {};
+
+template <typename Seq, typename... Types>
+struct index_map_impl;
+
+template <std::size_t... Is, typename... Types>
+struct index_map_impl<std::index_sequence<Is...>, Types...> : index_entry<Types, Is>... {};
+
+/**
+ * @brief Resolves T to its index by overload resolution against the bases of a map
+ * 
+ * Deduction fails (SFINAE) if T is not in the map or listed more than once.
+ */
+template <typename T, std::size_t I>
+constexpr std::size_t index_of(index_entry<T, I> const *) noexcept {
+    return I;
+}
+
+template <std::size_t I, typename T>
+struct indexed_element {
+    T value;
+};
+
+template <typename Seq, typename... Types>
+struct indexed_tuple_impl;
+
+template <std::size_t... Is, typename... Types>
+struct indexed_tuple_impl<std::index_sequence<Is...>, Types...> : indexed_element<Is, Types>... {
+    constexpr indexed_tuple_impl(Types... values)
+        : indexed_element<Is, Types>{ std::move(values) }... {}
+};
+
+/**
+ * @brief Access the I-th element of an indexed_tuple (one overload resolution, no recursion)
+ */
+template <std::size_t I, typename T>
+constexpr T &element_at(indexed_element<I, T> &element) noexcept {
+    return element.value;
+}
+
+template <std::size_t I, typename T>
+constexpr T const &element_at(indexed_element<I, T> const &element) noexcept {
+    return element.value;
+}
+
+template <std::size_t I, typename T>
+constexpr T &&element_at(indexed_element<I, T> &&element) noexcept {
+    return std::move(element.value);
+}
+
+template <typename T>
+constexpr std::string_view parse_type_name() noexcept {
+    std::string_view name = std::source_location::current().function_name();
+#if defined(__clang__) || defined(__GNUC__)
+    auto const start = name.find("T = ");
+    if(start == std::string_view::npos)
+        return name;
+    name.remove_prefix(start + 4);
+    return name.substr(0, name.find_first_of(";]"));
+#else
+    return name;
+#endif
+}
+
+/**
+ * @brief Readable name of T (as spelled by the compiler)
+ * 
+ * Parsed at compile time; calling it costs nothing at runtime.
+ */
+template <typename T>
+constexpr std::string_view type_name() noexcept {
+    constexpr auto name = parse_type_name<T>();
+    return name;
+}
+
+} // namespace detail
+
+/**
+ * @brief A flat tuple: one base class per element instead of a recursive chain
+ * 
+ * Keeps construction and access of large tuples at O(N) instantiations;
+ * elements are accessed with detail::element_at<I>.
+ * 
+ * @tparam Types The element types
+ */
+template <typename... Types>
+using indexed_tuple = detail::indexed_tuple_impl<std::index_sequence_for<Types...>, Types...>;
+
+/**
+ * @brief Maps each type of a list to its position
+ * 
+ * A single class deriving from one entry per type, so building it costs O(N)
+ * instantiations and each lookup is one overload resolution instead of
+ * a fold over the whole list.
+ * 
+ * @tparam Types List of types to map
+ */
+template <typename... Types>
+using type_index_map = detail::index_map_impl<std::index_sequence_for<Types...>, Types...>;
+
+/**
+ * @brief A requirement for T to be listed exactly once in an index map
+ * 
+ * @tparam T Type to look up
+ * @tparam Map A @ref type_index_map
+ */
+template <typename T, typename Map>
+concept MappedOnce = requires(Map const *map) {
+    detail::index_of<T>(map);
+};
+
+/**
+ * @brief Position of T in Types (required to be listed exactly once)
+ * 
+ * @tparam T Type to look up
+ * @tparam Types List of types to look in
+ */
+template <typename T, typename... Types>
+inline constexpr std::size_t index_in = detail::index_of<T>(static_cast<type_index_map<Types...> const *>(nullptr));
+
 /**
  * @brief Verifies that all types in the list are unique
  * 
+ * Each type has to resolve to exactly one index of the list's map: O(N) lookups.
+ * 
  * @tparam Types List of types to verify
  */
 template <typename... Types>
 struct check_unique {
-    static constexpr bool value = ((type_match_count<Types, Types...>::value == 1) && ...);
+    static constexpr bool value = (MappedOnce<Types, type_index_map<Types...>> && ...);
+};
+
+/**
+ * @brief A compile-time list of types
+ * 
+ * @tparam Types 
+ */
+template <typename... Types>
+struct type_list {};
+
+/**
+ * @brief Checks that T is listed in a type_list
+ * 
+ * @tparam T Type to match
+ * @tparam List The type_list to match against
+ */
+template <typename T, typename List>
+struct list_contains;
+
+template <typename T, typename... Types>
+struct list_contains<T, type_list<Types...>> : any_type_match<T, Types...> {};
+
+/**
+ * @brief Appends T to the end of a type_list
+ * 
+ * @tparam List The type_list to append to
+ * @tparam T Type to append
+ */
+template <typename List, typename T>
+struct list_append;
+
+template <typename... Types, typename T>
+struct list_append<type_list<Types...>, T> {
+    using type = type_list<Types..., T>;
 };
 
+/**
+ * @brief Always false; allows static_assert in templates that should never be instantiated
+ */
+template <typename...>
+inline constexpr bool always_false = false;
+
 } // namespace di
\ No newline at end of file
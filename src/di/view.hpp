@@ -0,0 +1,77 @@
+#pragma once
+
+#include <di/selection.hpp>
+
+#include <concepts>
+#include <functional>
+#include <memory>
+
+namespace di {
+
+/**
+ * @brief A requirement for H to expose its object as a raw pointer convertible to T*
+ * 
+ * @tparam H Holder type
+ * @tparam T 
+ */
+template <typename H, typename T>
+concept PointerLikeHolder = requires(H const &holder) {
+    { holder.operator->() } -> std::convertible_to<T *>;
+};
+
+/**
+ * @brief A non-owning Selection holder type.
+ * 
+ * Borrows the object from any pointer-like holder (`std::shared_ptr`, 
+ * @ref LazyHolder, another ViewHolder) or from a reference without 
+ * touching any reference counts. The borrowed object must outlive the view.
+ * 
+ * Borrowing from a @ref LazyHolder resolves it.
+ * 
+ * @tparam T
+ */
+template <typename T>
+class ViewHolder {
+    T *ptr_;
+
+public:
+    /**
+     * @brief Borrow an object by reference.
+     * 
+     * @param ref The object
+     */
+    constexpr ViewHolder(T &ref)
+        : ptr_{ std::addressof(ref) } {}
+
+    /**
+     * @brief Borrow the object of a reference wrapper.
+     * 
+     * @param ref The wrapper (possibly of a non-const object when T is const)
+     */
+    template <typename U>
+    constexpr ViewHolder(std::reference_wrapper<U> ref) requires std::convertible_to<U *, T *>
+        : ptr_{ std::addressof(ref.get()) } {}
+
+    /**
+     * @brief Borrow the object of any pointer-like holder.
+     * 
+     * @param holder The holder (possibly of a non-const object when T is const)
+     */
+    template <typename H>
+    constexpr ViewHolder(H const &holder) requires PointerLikeHolder<H, T>
+        : ptr_{ holder.operator->() } {}
+
+    constexpr T *get() const noexcept { return ptr_; }
+    constexpr T *operator->() const noexcept { return ptr_; }
+    constexpr T &operator*() const noexcept { return *ptr_; }
+};
+
+/**
+ * @brief A selection of ViewHolder can borrow from selections of any holder type
+ */
+template <>
+struct holder_traits<ViewHolder> {
+    static constexpr bool borrowing = true;
+};
+
+} // namespace di
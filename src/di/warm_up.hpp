@@ -0,0 +1,96 @@
+#pragma once
+
+#include <di/executor.hpp>
+#include <di/lazy.hpp>
+#include <di/selection.hpp>
+
+#include <atomic>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+
+namespace di {
+
+namespace detail {
+
+/**
+ * @brief Completion state shared by all tasks of one warm-up
+ */
+class warm_up_state {
+    std::atomic<std::size_t> remaining_;
+    std::mutex mtx_;
+    std::exception_ptr error_;
+    std::promise<void> done_;
+
+public:
+    explicit warm_up_state(std::size_t count)
+        : remaining_{ count } {}
+
+    std::future<void> future() {
+        return done_.get_future();
+    }
+
+    void fail(std::exception_ptr error) {
+        std::lock_guard<std::mutex> g(mtx_);
+        if(not error_)
+            error_ = error;
+    }
+
+    void complete() {
+        if(remaining_.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+
+        std::lock_guard<std::mutex> g(mtx_);
+        if(error_)
+            done_.set_exception(error_);
+        else
+            done_.set_value();
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Resolve lazy services in the background
+ * 
+ * Posts one task per service to the executor. Services are posted in the
+ * order they are listed in Ts (all of Types if Ts is empty), so with a FIFO 
+ * executor such as @ref ThreadPool the first listed services start first:
+ * @code
+ *   auto ready = warm_up<Database, Cache>(services, pool); // Database has priority
+ * @endcode
+ * 
+ * Callers that access a service while it is being warmed up wait for the 
+ * in-flight initialization instead of running the factory again.
+ * 
+ * @tparam Ts The services to warm up in priority order (all if empty)
+ * @param selection The lazy services
+ * @param executor Runs the factories
+ * @return std::future<void> Ready once all services are resolved, holds the first factory exception if any
+ */
+template <typename... Ts, typename... Types, Executor E>
+std::future<void> warm_up(Selection<LazyHolder, Types...> const &selection, E &executor) {
+    if constexpr(sizeof...(Ts) == 0) {
+        return warm_up<Types...>(selection, executor);
+    } else {
+        auto state  = std::make_shared<detail::warm_up_state>(sizeof...(Ts));
+        auto future = state->future();
+
+        auto post = [&](auto holder) {
+            executor.post([holder, state] {
+                try {
+                    holder.operator->();
+                } catch(...) {
+                    state->fail(std::current_exception());
+                }
+                state->complete();
+            });
+        };
+        (post(selection.template get<Ts>()), ...);
+
+        return future;
+    }
+}
+
+} // namespace di
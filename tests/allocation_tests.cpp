@@ -0,0 +1,95 @@
+#include "allocations.hpp"
+#include "types.hpp"
+#include <di.hpp>
+
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace di;
+
+// Locks in the heap allocations of each Selection operation:
+// hot paths (get, narrowing, resolved lazy access) must not allocate at all.
+
+TEST(AllocationTest, DepsHotPathsDoNotAllocate) {
+    A a;
+    B b;
+    C c;
+    Deps<A, B, C> deps{ std::ref(a), std::ref(b), std::ref(c) };
+
+    EXPECT_EQ(count_allocations([&] { EXPECT_EQ(&deps.get<B>().get(), &b); }).allocations, 0);
+    EXPECT_EQ(count_allocations([&] {
+        Deps<const A, C> narrowed = deps;
+        EXPECT_EQ(&narrowed.get<A>().get(), &a);
+    }).allocations,
+        0);
+    EXPECT_EQ(count_allocations([&] {
+        auto [ra, rc] = deps.get<A, C>();
+        EXPECT_EQ(&rc.get(), &c);
+    }).allocations,
+        0);
+}
+
+TEST(AllocationTest, ServicesHotPathsDoNotAllocate) {
+    Services<A, B, C> services;
+
+    EXPECT_EQ(count_allocations([&] { EXPECT_NE(services.get<B>(), nullptr); }).allocations, 0);
+    EXPECT_EQ(count_allocations([&] {
+        Services<const A, C> narrowed = services;
+        EXPECT_NE(narrowed.get<A>(), nullptr);
+    }).allocations,
+        0);
+    EXPECT_EQ(count_allocations([&] {
+        SelectionView<A, const C> view = services;
+        EXPECT_EQ(view.get<C>().get(), services.get<C>().get());
+    }).allocations,
+        0);
+    EXPECT_EQ(count_allocations([&] {
+        auto combined = combine(services, Services<D>{ std::shared_ptr<D>{} });
+        EXPECT_NE(combined.get<A>(), nullptr);
+    }).allocations,
+        0);
+}
+
+TEST(AllocationTest, ServicesConstruction) {
+    auto const each = count_allocations([] {
+        Services<A, B, C> services;
+        EXPECT_NE(services.get<A>(), nullptr);
+    });
+    EXPECT_EQ(each.allocations, 3); // one control block + object per service
+    EXPECT_GE(each.bytes, sizeof(A) + sizeof(B) + sizeof(C));
+
+    auto const arena = count_allocations([] {
+        Services<A, B, C> services{ in_arena };
+        EXPECT_NE(services.get<A>(), nullptr);
+    });
+    EXPECT_EQ(arena.allocations, 1);
+
+    Services<A, B> ab;
+    EXPECT_EQ(count_allocations([&] {
+        auto extended = extend(ab, std::make_shared<C>());
+        EXPECT_NE(extended.get<C>(), nullptr);
+    }).allocations,
+        1); // only the new service
+}
+
+TEST(AllocationTest, LazyServices) {
+    std::unique_ptr<LazyServices<A, B>> services;
+    EXPECT_EQ(count_allocations([&] {
+        services = std::make_unique<LazyServices<A, B>>(
+            [] { return std::make_shared<A>(); },
+            [] { return B{}; });
+    }).allocations,
+        3); // the selection itself + one state per holder (B stored in place)
+
+    EXPECT_EQ(count_allocations([&] { EXPECT_EQ(services->get<A>()->value, 1234); }).allocations, 1); // the factory's make_shared
+    EXPECT_EQ(count_allocations([&] { EXPECT_FALSE(services->get<B>()->value); }).allocations, 0);    // in place
+
+    // resolved
+    EXPECT_EQ(count_allocations([&] {
+        EXPECT_EQ(services->get<A>()->value, 1234);
+        EXPECT_FALSE(services->get<B>()->value);
+        LazyServices<const A> narrowed = *services;
+        EXPECT_EQ(narrowed.get<A>()->value, 1234);
+    }).allocations,
+        0);
+}
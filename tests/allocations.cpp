@@ -0,0 +1,49 @@
+#include "allocations.hpp"
+
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocation functions to count allocations per thread.
+// The array and nothrow forms forward to these by default.
+
+namespace {
+
+void *counted_allocate(std::size_t size, std::size_t alignment) {
+    ++thread_allocations.allocations;
+    thread_allocations.bytes += size;
+
+    if(size == 0)
+        size = 1;
+    void *ptr = alignment <= alignof(std::max_align_t)
+        ? std::malloc(size)
+        : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    if(not ptr)
+        throw std::bad_alloc{};
+    return ptr;
+}
+
+} // namespace
+
+void *operator new(std::size_t size) {
+    return counted_allocate(size, alignof(std::max_align_t));
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    return counted_allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief Allocations made through the global operator new
+ */
+struct AllocationCount {
+    std::size_t allocations = 0;
+    std::size_t bytes       = 0;
+
+    AllocationCount operator-(AllocationCount const &other) const {
+        return { allocations - other.allocations, bytes - other.bytes };
+    }
+};
+
+/**
+ * @brief Running total of the calling thread, updated by the replaced operator new (allocations.cpp)
+ */
+inline thread_local AllocationCount thread_allocations;
+
+/**
+ * @brief Counts the allocations made by the calling thread while alive
+ */
+class AllocationScope {
+    AllocationCount start_ = thread_allocations;
+
+public:
+    AllocationCount count() const {
+        return thread_allocations - start_;
+    }
+};
+
+/**
+ * @brief Count the allocations made by the calling thread while running fn
+ */
+template <typename Fn>
+AllocationCount count_allocations(Fn &&fn) {
+    AllocationScope scope;
+    fn();
+    return scope.count();
+}
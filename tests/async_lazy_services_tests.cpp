@@ -0,0 +1,105 @@
+#include "types.hpp"
+#include <di.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace di;
+
+TEST(AsyncLazyServicesTest, LazyOnly) {
+    auto a_created = false;
+    auto services  = AsyncLazyServices<A, B>{
+        [&a_created]() -> Task<std::shared_ptr<A>> {
+            a_created = true;
+            co_return std::make_shared<A>();
+        },
+        []() -> Task<B> { co_return B{ true }; }
+    };
+
+    auto a = services.get<A>();
+    EXPECT_FALSE(a_created);
+    EXPECT_FALSE(a.loaded());
+
+    auto resolved = sync_wait([](AsyncLazyServices<A, B> services) -> Task<int> {
+        auto a = co_await services.get<A>();
+        auto b = co_await services.get<B>();
+        co_return a->value + b->value;
+    }(services));
+
+    EXPECT_TRUE(a_created);
+    EXPECT_TRUE(a.loaded());
+    EXPECT_EQ(resolved, 1235);
+}
+
+TEST(AsyncLazyServicesTest, NarrowingAndConstPromotion) {
+    auto services = AsyncLazyServices<A, B, C>{
+        std::make_shared<A>(), // eager
+        []() -> Task<B> { co_return B{}; },
+        []() -> Task<C> { co_return C{}; }
+    };
+
+    AsyncLazyServices<const A, B> narrowed = services;
+    auto ca                                = services.get<const A>();
+    static_assert(std::is_same_v<decltype(ca), AsyncLazyHolder<const A>>);
+    EXPECT_TRUE(ca.loaded());
+
+    auto a = sync_wait([](AsyncLazyServices<const A, B> services) -> Task<std::shared_ptr<const A>> {
+        co_return co_await services.get<A>();
+    }(narrowed));
+    EXPECT_EQ(a, sync_wait([](AsyncLazyHolder<A> holder) -> Task<std::shared_ptr<A>> {
+        co_return co_await holder;
+    }(services.get<A>())));
+}
+
+TEST(AsyncLazyServicesTest, ConcurrentAwaitersShareOneConstruction) {
+    constexpr auto awaiter_count    = 16;
+    std::atomic<int> a_create_count = 0;
+    std::atomic<int> done           = 0;
+    std::atomic<int> sum            = 0;
+    std::promise<void> all_done;
+
+    ThreadPool pool{ 1 }; // a blocked worker would deadlock the factory
+    auto services = AsyncLazyServices<A>{
+        [&pool, &a_create_count]() -> Task<A> {
+            ++a_create_count;
+            co_await schedule(pool); // let the awaiters pile up
+            co_return A{ 42 };
+        }
+    };
+
+    for(auto i = 0; i < awaiter_count; ++i)
+        spawn(pool, [](AsyncLazyServices<A> services, std::atomic<int> &done, std::atomic<int> &sum, std::promise<void> &all_done) -> Task<> {
+            sum += (co_await services.get<A>())->value;
+            if(++done == awaiter_count)
+                all_done.set_value();
+        }(services, done, sum, all_done));
+
+    ASSERT_EQ(all_done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(a_create_count, 1);
+    EXPECT_EQ(sum, 42 * awaiter_count);
+}
+
+TEST(AsyncLazyServicesTest, FailedFactoryIsRetried) {
+    auto attempts = 0;
+    auto services = AsyncLazyServices<A>{
+        [&attempts]() -> Task<A> {
+            if(++attempts == 1)
+                throw std::runtime_error("failed");
+            co_return A{};
+        }
+    };
+
+    auto resolve = [](AsyncLazyServices<A> services) -> Task<int> {
+        co_return(co_await services.get<A>())->value;
+    };
+
+    EXPECT_THROW(sync_wait(resolve(services)), std::runtime_error);
+    EXPECT_FALSE(services.get<A>().loaded());
+    EXPECT_EQ(sync_wait(resolve(services)), 1234);
+    EXPECT_EQ(attempts, 2);
+}
@@ -0,0 +1,147 @@
+#include "types.hpp"
+#include <di.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace di;
+
+namespace {
+
+std::vector<std::string> constructed;
+
+struct Log {
+    Log() { constructed.push_back("Log"); }
+};
+
+struct Network {
+    using services_t = Services<Log>;
+    Network(services_t services)
+        : services_{ services } { constructed.push_back("Network"); }
+    services_t services_;
+};
+
+struct Watchdog {
+    using services_t = Services<const Log, Network>;
+    Watchdog(services_t services)
+        : services_{ services } { constructed.push_back("Watchdog"); }
+    services_t services_;
+};
+
+struct Monitor {
+    using services_t = SelectionView<const Watchdog, const Log>;
+    Monitor(services_t services)
+        : services_{ services } { constructed.push_back("Monitor"); }
+    services_t services_;
+};
+
+// records when construction of each Slow<N> started and finished
+std::atomic<int> ticks{ 0 };
+int started[6];
+int finished[6];
+
+template <int N, typename... Deps>
+struct Slow {
+    using services_t = Services<const Deps...>;
+    Slow(services_t) {
+        started[N] = ++ticks;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        finished[N] = ++ticks;
+    }
+};
+
+using S0 = Slow<0>;
+using S1 = Slow<1>;
+using S2 = Slow<2, S0, S1>;
+using S3 = Slow<3, S0>;
+using S4 = Slow<4, S2, S3>;
+using S5 = Slow<5, S1>;
+
+struct Throwing {
+    Throwing() { throw std::runtime_error("failed"); }
+};
+
+struct Ping;
+struct Pong {
+    using services_t = Services<Ping>;
+};
+struct Ping {
+    using services_t = Services<const Pong>;
+};
+
+} // namespace
+
+TEST(InjectorTest, ConstructionOrder) {
+    using order_t = construction_order_t<Watchdog, Config>;
+    static_assert(std::is_same_v<order_t, type_list<Log, Network, Watchdog, Config>>);
+    static_assert(std::is_same_v<construction_order_t<Network, Log>, type_list<Log, Network>>);
+    static_assert(std::is_same_v<construction_order_t<const Network>, type_list<Log, Network>>);
+
+    // construction_order_t<Ping> invalid; - Ping and Pong depend on each other
+}
+
+TEST(InjectorTest, BuildsGraphOnce) {
+    constructed.clear();
+    auto services = Injector<Watchdog, Config>::build();
+    static_assert(std::is_same_v<decltype(services), Services<Log, Network, Watchdog, Config>>);
+
+    EXPECT_EQ(constructed, (std::vector<std::string>{ "Log", "Network", "Watchdog" }));
+    EXPECT_EQ(services.get<Config>()->severity, 3);
+
+    // everyone shares the same instances
+    auto log = services.get<Log>();
+    EXPECT_EQ(services.get<Network>()->services_.get<Log>(), log);
+    EXPECT_EQ(services.get<Watchdog>()->services_.get<Log>(), log);
+    EXPECT_EQ(services.get<Watchdog>()->services_.get<Network>(), services.get<Network>());
+}
+
+TEST(InjectorTest, ConstructsFromAnyCompatibleSelection) {
+    constructed.clear();
+    auto services = Injector<Monitor>::build();
+
+    EXPECT_EQ(constructed, (std::vector<std::string>{ "Log", "Network", "Watchdog", "Monitor" }));
+    EXPECT_EQ(services.get<Monitor>()->services_.get<Watchdog>().get(), services.get<Watchdog>().get());
+}
+
+TEST(InjectorTest, ConstructionLevels) {
+    static_assert(construction_level_v<Log> == 0);
+    static_assert(construction_level_v<Network> == 1);
+    static_assert(construction_level_v<const Watchdog> == 2);
+    static_assert(construction_level_v<S4> == 2);
+    static_assert(construction_level_v<S5> == 1);
+}
+
+TEST(InjectorTest, ParallelBuildRespectsDependencies) {
+    ticks = 0;
+    ThreadPool pool{ 4 };
+    auto services = Injector<S4, S5>::build(pool);
+    static_assert(std::is_same_v<decltype(services), Services<S0, S1, S2, S3, S4, S5>>);
+
+    auto before = [](int dep, int service) { return finished[dep] < started[service]; };
+    EXPECT_TRUE(before(0, 2));
+    EXPECT_TRUE(before(1, 2));
+    EXPECT_TRUE(before(0, 3));
+    EXPECT_TRUE(before(2, 4));
+    EXPECT_TRUE(before(3, 4));
+    EXPECT_TRUE(before(1, 5));
+}
+
+TEST(InjectorTest, ParallelBuildBuildsGraphOnce) {
+    constructed.clear();
+    ThreadPool pool{ 1 }; // constructed is not thread-safe
+    auto services = Injector<Watchdog>::build(pool);
+
+    EXPECT_EQ(constructed, (std::vector<std::string>{ "Log", "Network", "Watchdog" }));
+    EXPECT_EQ(services.get<Watchdog>()->services_.get<Network>(), services.get<Network>());
+}
+
+TEST(InjectorTest, ParallelBuildRethrows) {
+    ThreadPool pool{ 2 };
+    using injector_t = Injector<Throwing, Config>;
+    EXPECT_THROW(injector_t::build(pool), std::runtime_error);
+}
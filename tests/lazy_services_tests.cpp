@@ -2,9 +2,14 @@
 #include <di.hpp>
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <gtest/gtest.h>
+#include <mutex>
+#include <stdexcept>
 #include <string>
 #include <thread>
+#include <vector>
 
 using namespace di;
 
@@ -90,6 +95,7 @@ TEST(LazyServicesTest, MultiThreadLazyLoadsOnce) {
     auto services       = LazyServices<A, B>{
         [&a_create_count] {
             ++a_create_count;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10)); // let other threads pile up
             return std::make_shared<A>();
         },
         [&b_create_count] {
@@ -99,13 +105,22 @@ TEST(LazyServicesTest, MultiThreadLazyLoadsOnce) {
     };
 
     EXPECT_EQ(a_create_count, 0);
-    std::atomic<std::size_t> calls = 0;
+    std::atomic<std::size_t> calls      = 0;
+    std::atomic<std::size_t> mismatches = 0;
+    std::atomic<bool> go                = false;
 
-    auto fn = [&services, &calls] {
+    auto fn = [&services, &calls, &mismatches, &go] {
         ++calls;
+        while(not go)
+            std::this_thread::yield();
+
+        auto const expected = services.get<A>().get().get();
         for(auto i = 0; i < 100; ++i) {
             [[maybe_unused]] auto a = services.get<A>().get();
             [[maybe_unused]] auto b = services.get<B>().get();
+            if(a.get() != expected or &services.get<A>()->value != &expected->value)
+                ++mismatches;
+            [[maybe_unused]] auto _ = services.get<B>()->value;
         }
     };
 
@@ -114,10 +129,181 @@ TEST(LazyServicesTest, MultiThreadLazyLoadsOnce) {
 
     for(auto i = 0; i < thread_count; ++i)
         threads.emplace_back(fn);
+    go = true;
     for(auto &thread : threads)
         thread.join();
 
     EXPECT_EQ(a_create_count, 1);
     EXPECT_EQ(b_create_count, 1);
     EXPECT_EQ(calls, thread_count);
+    EXPECT_EQ(mismatches, 0);
+}
+
+TEST(LazyServicesTest, EagerInstanceIsReturnedAsIs) {
+    auto b        = std::make_shared<B>();
+    auto services = LazyServices<B>{ b };
+
+    EXPECT_EQ(services.get<B>().get(), b);
+    EXPECT_EQ(&services.get<B>()->value, &b->value);
+}
+
+TEST(LazyServicesTest, IndependentHoldersLoadConcurrently) {
+    std::mutex mtx;
+    std::condition_variable cv;
+    auto started = 0;
+
+    // each factory blocks until both factories are running at the same time
+    auto factory = [&mtx, &cv, &started] {
+        std::unique_lock lock(mtx);
+        ++started;
+        cv.notify_all();
+        auto const both = cv.wait_for(lock, std::chrono::seconds(5), [&started] { return started == 2; });
+        auto a          = std::make_shared<A>();
+        a->value        = both ? 1 : 0;
+        return a;
+    };
+
+    auto first  = LazyServices<A>{ factory };
+    auto second = LazyServices<A>{ factory };
+
+    auto value_first  = 0;
+    auto value_second = 0;
+    auto t1           = std::thread([&] { value_first = first.get<A>()->value; });
+    auto t2           = std::thread([&] { value_second = second.get<A>()->value; });
+    t1.join();
+    t2.join();
+
+    EXPECT_EQ(started, 2);
+    EXPECT_EQ(value_first, 1);
+    EXPECT_EQ(value_second, 1);
+}
+
+TEST(LazyServicesTest, FactoryCanResolveAnotherHolderOfSameType) {
+    auto inner = LazyServices<A>{ [] {
+        auto a   = std::make_shared<A>();
+        a->value = 42;
+        return a;
+    } };
+    auto outer = LazyServices<A>{ [inner] {
+        auto a   = std::make_shared<A>();
+        a->value = inner.get<A>()->value + 1;
+        return a;
+    } };
+
+    EXPECT_EQ(outer.get<A>()->value, 43);
+    EXPECT_EQ(inner.get<A>()->value, 42);
+}
+
+TEST(LazyServicesTest, ValueFactoryConstructsInPlace) {
+    auto c_create_count = 0;
+    auto services       = LazyServices<A, C>{
+        std::make_shared<A>(),
+        [&c_create_count] {
+            ++c_create_count;
+            return C{ "InPlace" };
+        }
+    };
+
+    EXPECT_EQ(c_create_count, 0);
+    EXPECT_STREQ(services.get<C>()->value.c_str(), "InPlace");
+    EXPECT_EQ(c_create_count, 1);
+
+    auto ptr = services.get<C>().get();
+    static_assert(std::is_same_v<decltype(ptr), std::shared_ptr<C>>);
+    EXPECT_EQ(ptr.get(), services.get<C>().get().get());
+    EXPECT_EQ(c_create_count, 1);
+}
+
+TEST(LazyServicesTest, ConstPromotionSharesState) {
+    auto a_create_count = 0;
+    auto services       = LazyServices<A, B>{
+        [&a_create_count] {
+            ++a_create_count;
+            return A{};
+        },
+        [] { return std::make_shared<B>(); }
+    };
+
+    LazyServices<const A> readonly = services;
+    auto ca                        = services.get<const A>();
+    static_assert(std::is_same_v<decltype(ca), LazyHolder<const A>>);
+    static_assert(std::is_same_v<decltype(readonly.get<A>().get()), std::shared_ptr<const A>>);
+
+    services.get<A>()->value = 42;
+    EXPECT_EQ(readonly.get<A>()->value, 42);
+    EXPECT_EQ(ca->value, 42);
+    EXPECT_EQ(a_create_count, 1);
+}
+
+TEST(LazyServicesTest, WarmUpRunsEachFactoryOnce) {
+    std::atomic<int> a_create_count = 0;
+    std::atomic<int> b_create_count = 0;
+    auto services                   = LazyServices<A, B>{
+        [&a_create_count] {
+            ++a_create_count;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            return A{};
+        },
+        [&b_create_count] {
+            ++b_create_count;
+            return B{};
+        }
+    };
+
+    ThreadPool pool{ 2 };
+    auto ready = warm_up(services, pool);
+
+    // callers racing ahead of the warm-up wait for it
+    auto threads = std::vector<std::thread>{};
+    for(auto i = 0; i < 8; ++i)
+        threads.emplace_back([&services] {
+            [[maybe_unused]] auto a = services.get<A>()->value;
+            [[maybe_unused]] auto b = services.get<B>()->value;
+        });
+    for(auto &thread : threads)
+        thread.join();
+
+    ready.get();
+    EXPECT_TRUE(services.get<A>().loaded());
+    EXPECT_TRUE(services.get<B>().loaded());
+    EXPECT_EQ(a_create_count, 1);
+    EXPECT_EQ(b_create_count, 1);
+}
+
+TEST(LazyServicesTest, WarmUpInPriorityOrder) {
+    std::vector<std::string> created;
+    auto services = LazyServices<A, B, C>{
+        [&created] {
+            created.push_back("A");
+            return A{};
+        },
+        [&created] {
+            created.push_back("B");
+            return B{};
+        },
+        [&created] {
+            created.push_back("C");
+            return C{};
+        }
+    };
+
+    ThreadPool pool{ 1 };
+    warm_up<C, A>(services, pool).get();
+
+    EXPECT_EQ(created, (std::vector<std::string>{ "C", "A" }));
+    EXPECT_FALSE(services.get<B>().loaded());
+}
+
+TEST(LazyServicesTest, WarmUpReportsFactoryErrors) {
+    auto services = LazyServices<A, B>{
+        []() -> A { throw std::runtime_error("failed"); },
+        [] { return B{}; }
+    };
+
+    ThreadPool pool{ 1 };
+    auto ready = warm_up(services, pool);
+
+    EXPECT_THROW(ready.get(), std::runtime_error);
+    EXPECT_FALSE(services.get<A>().loaded());
+    EXPECT_TRUE(services.get<B>().loaded());
 }
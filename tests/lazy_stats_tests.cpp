@@ -0,0 +1,96 @@
+// built as its own executable with DI_LAZY_STATS defined (see CMakeLists.txt)
+
+#include <di.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+using namespace di;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Counted {
+    int value = 1;
+};
+
+struct Slow {
+    int value = 2;
+};
+
+struct Contended {
+    int value = 3;
+};
+
+} // namespace
+
+static_assert(lazy_stats_enabled);
+
+TEST(LazyStatsTest, CountsAccessesAndCreation) {
+    auto services = LazyServices<Counted, Slow>{
+        [] { return Counted{}; },
+        [] {
+            std::this_thread::sleep_for(2ms);
+            return Slow{};
+        }
+    };
+    reset_lazy_stats();
+
+    auto counted = services.get<Counted>();
+    EXPECT_EQ(counted->value, 1);
+    EXPECT_EQ(counted->value, 1);
+    EXPECT_EQ((*counted)->value, 1);
+    EXPECT_EQ(services.get<Slow>()->value, 2);
+
+    auto const stats = lazy_stats_of<Counted>();
+    EXPECT_EQ(stats.accesses, 3);
+    EXPECT_EQ(stats.creations, 1);
+    EXPECT_EQ(stats.waiters, 0);
+
+    auto const slow = lazy_stats_of<Slow>();
+    EXPECT_EQ(slow.accesses, 1);
+    EXPECT_EQ(slow.creations, 1);
+    EXPECT_GE(slow.factory_ns, std::chrono::nanoseconds(2ms).count());
+}
+
+TEST(LazyStatsTest, RecordsWaitsOnInitialization) {
+    std::atomic<bool> started = false;
+    auto services             = LazyServices<Contended>{ [&started] {
+        started = true;
+        std::this_thread::sleep_for(50ms);
+        return Contended{};
+    } };
+    reset_lazy_stats();
+
+    auto holder = services.get<Contended>();
+    std::thread creator([&] { EXPECT_EQ(holder->value, 3); });
+    while(not started)
+        std::this_thread::yield();
+    EXPECT_EQ(holder->value, 3); // blocks until the creator is done
+    creator.join();
+
+    auto const stats = lazy_stats_of<Contended>();
+    EXPECT_EQ(stats.accesses, 2);
+    EXPECT_EQ(stats.creations, 1);
+    EXPECT_EQ(stats.waiters, 1);
+    EXPECT_GT(stats.wait_ns, 0);
+}
+
+TEST(LazyStatsTest, DumpsAndResets) {
+    auto services = LazyServices<Counted>{ [] { return Counted{}; } };
+    EXPECT_EQ(services.get<Counted>()->value, 1);
+
+    auto const json = lazy_stats_json();
+    EXPECT_NE(json.find("\"type\": \"" + lazy_stats_of<Counted>().type + "\""), std::string::npos);
+    EXPECT_NE(json.find("\"factory_ns\": "), std::string::npos);
+    EXPECT_EQ(json.front(), '[');
+    EXPECT_EQ(json.back(), ']');
+
+    reset_lazy_stats();
+    auto const stats = lazy_stats_of<Counted>();
+    EXPECT_EQ(stats.accesses, 0);
+    EXPECT_EQ(stats.creations, 0);
+}
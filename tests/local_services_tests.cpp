@@ -0,0 +1,71 @@
+#include "types.hpp"
+#include <di.hpp>
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+using namespace di;
+
+TEST(LocalServicesTest, ConstUsage) {
+    LocalServices<A, B> ab;
+    LocalServices<B, A> ba   = ab;
+    LocalServices<const B> b = ba;
+    auto ncb                 = b.get<B>(); // implicit const get
+    static_assert(std::is_same_v<decltype(ncb), LocalPtr<const B>>);
+
+    auto cb = ab.get<const B>(); // explicit const get
+    static_assert(std::is_same_v<decltype(cb), LocalPtr<const B>>);
+    EXPECT_EQ(cb.get(), ab.get<B>().get());
+
+    LocalServices<Config, const B, A, C> top_level;
+    top_level.get<Config>()->severity = 4;
+
+    LocalServices<const Config, A> a_user = top_level;
+    EXPECT_EQ(a_user.get<Config>()->severity, 4);
+}
+
+TEST(LocalServicesTest, ExtendingAndCombining) {
+    LocalServices<A, B> services;
+    auto extended = extend(services, make_local<C>());
+    static_assert(std::is_same_v<decltype(extended), LocalServices<A, B, C>>);
+
+    auto combined = combine(extended, LocalServices<Config, const D>{});
+    static_assert(std::is_same_v<decltype(combined), LocalServices<A, B, C, Config, const D>>);
+
+    combined.get<C>()->value = "Changed";
+    EXPECT_STREQ(extended.get<C>()->value.c_str(), "Changed");
+    EXPECT_EQ(combined.get<D>()->value, 0.42f);
+}
+
+TEST(LocalServicesTest, CountsReferences) {
+    auto destroyed = 0;
+    struct Tracked {
+        int &destroyed;
+        ~Tracked() { ++destroyed; }
+    };
+
+    {
+        auto ptr = make_local<Tracked>(destroyed);
+        EXPECT_EQ(ptr.use_count(), 1);
+        {
+            LocalServices<const Tracked> services{ ptr };
+            auto copy = services;
+            EXPECT_EQ(ptr.use_count(), 3);
+        }
+        EXPECT_EQ(ptr.use_count(), 1);
+
+        auto moved = std::move(ptr);
+        EXPECT_FALSE(ptr);
+        EXPECT_EQ(moved.use_count(), 1);
+        EXPECT_EQ(destroyed, 0);
+    }
+    EXPECT_EQ(destroyed, 1);
+}
+
+#ifndef NDEBUG
+TEST(LocalServicesDeathTest, AssertsOnCrossThreadUse) {
+    LocalServices<A> services;
+    EXPECT_DEATH(std::thread([&] { [[maybe_unused]] auto copy = services; }).join(), "another thread");
+}
+#endif
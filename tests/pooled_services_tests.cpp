@@ -0,0 +1,136 @@
+#include "types.hpp"
+#include <di.hpp>
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace di;
+
+namespace {
+
+struct Worker {
+    inline static std::atomic<int> created = 0;
+    std::vector<int> table = std::vector<int>(256);
+    int jobs               = 0;
+
+    Worker() { ++created; }
+
+    int run() { return ++jobs; }
+};
+
+PoolOptions single_shard(std::size_t capacity) {
+    return PoolOptions{ .capacity = capacity, .prefill = 0, .shards = 1 };
+}
+
+} // namespace
+
+TEST(PooledServicesTest, ReleasedInstancesAreReused) {
+    Worker::created = 0;
+    PooledServices<Worker> services{ PooledHolder<Worker>{ single_shard(4) } };
+
+    Worker *first = nullptr;
+    {
+        auto lease = services.get<Worker>().acquire();
+        first      = lease.get();
+        EXPECT_EQ(lease->run(), 1);
+    }
+    EXPECT_EQ(services.get<Worker>().idle(), 1);
+
+    auto lease = services.get<Worker>().acquire();
+    EXPECT_EQ(lease.get(), first);
+    EXPECT_EQ(lease->run(), 2);
+    EXPECT_EQ(Worker::created, 1);
+}
+
+TEST(PooledServicesTest, ArrowLeasesForTheFullExpression) {
+    Worker::created = 0;
+    PooledServices<Worker> services{ PooledHolder<Worker>{ single_shard(4) } };
+
+    EXPECT_EQ(services.get<Worker>()->run(), 1);
+    EXPECT_EQ(services.get<Worker>()->run(), 2);
+    EXPECT_EQ(services.get<Worker>().idle(), 1);
+
+    // concurrent leases get distinct instances
+    auto a = services.get<Worker>().acquire();
+    auto b = services.get<Worker>().acquire();
+    EXPECT_NE(a.get(), b.get());
+    EXPECT_EQ(Worker::created, 2);
+}
+
+TEST(PooledServicesTest, ResetHookAndCapacity) {
+    Worker::created = 0;
+    auto resets     = 0;
+    PooledServices<Worker> services{ PooledHolder<Worker>{
+        [] { return Worker{}; },
+        single_shard(2),
+        [&](Worker &w) {
+            w.jobs = 0;
+            ++resets;
+        } } };
+
+    {
+        std::vector<Lease<Worker>> leases;
+        for(auto i = 0; i < 3; ++i) {
+            leases.push_back(services.get<Worker>().acquire());
+            leases.back()->run();
+        }
+    }
+
+    EXPECT_EQ(resets, 3);
+    EXPECT_EQ(services.get<Worker>().idle(), 2); // the third one was destroyed
+    EXPECT_EQ(services.get<Worker>()->jobs, 0);
+}
+
+TEST(PooledServicesTest, CapacityBelowShardCount) {
+    Worker::created = 0;
+    PooledServices<Worker> services{ PooledHolder<Worker>{ PoolOptions{ .capacity = 3, .prefill = 8, .shards = 8 } } };
+    EXPECT_EQ(services.get<Worker>().idle(), 3);
+
+    std::atomic<int> leased = 0;
+    std::vector<std::thread> threads;
+    for(auto t = 0; t < 8; ++t)
+        threads.emplace_back([&leased, holder = services.get<Worker>()] {
+            auto lease = holder.acquire();
+            ++leased;
+            while(leased < 8) // all leases held at once, then released from every thread
+                std::this_thread::yield();
+        });
+    for(auto &thread : threads)
+        thread.join();
+
+    EXPECT_EQ(Worker::created, 8);
+    EXPECT_EQ(services.get<Worker>().idle(), 3);
+}
+
+TEST(PooledServicesTest, PrefillAndConstPromotion) {
+    Worker::created = 0;
+    PooledServices<Worker> services{ PooledHolder<Worker>{ PoolOptions{ .capacity = 8, .prefill = 4, .shards = 2 } } };
+    EXPECT_EQ(Worker::created, 4);
+    EXPECT_EQ(services.get<Worker>().idle(), 4);
+
+    PooledServices<const Worker> readonly = services;
+    EXPECT_EQ(readonly.get<Worker>()->table.size(), 256);
+    EXPECT_EQ(Worker::created, 4);
+}
+
+TEST(PooledServicesTest, MultiThreadedChurn) {
+    Worker::created = 0;
+    PooledServices<Worker> services{ PooledHolder<Worker>{ PoolOptions{ .capacity = 16, .prefill = 0, .shards = 4 } } };
+    std::atomic<int> jobs = 0;
+
+    std::vector<std::thread> threads;
+    for(auto t = 0; t < 4; ++t)
+        threads.emplace_back([&] {
+            for(auto i = 0; i < 1000; ++i) {
+                services.get<Worker>()->run();
+                ++jobs;
+            }
+        });
+    for(auto &t : threads)
+        t.join();
+
+    EXPECT_EQ(jobs, 4000);
+    EXPECT_LE(Worker::created, 16 + 4);
+}
@@ -0,0 +1,108 @@
+#include "types.hpp"
+#include <di.hpp>
+
+#include <gtest/gtest.h>
+#include <latch>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace di;
+
+namespace {
+
+struct Routes {
+    std::vector<std::string> paths;
+};
+
+} // namespace
+
+TEST(ReplicatedServicesTest, EachShardHoldsACopy) {
+    auto routes   = Routes{ { "/", "/health" } };
+    auto services = ReplicatedServices<const Routes>{ ReplicatedHolder<const Routes>{ routes, ReplicaOptions{ .shards = 4 } } };
+    auto holder   = services.get<Routes>();
+    static_assert(std::is_same_v<decltype(holder), ReplicatedHolder<const Routes>>);
+
+    EXPECT_EQ(holder.shards(), 4);
+    EXPECT_EQ(holder->paths.size(), 2);
+    EXPECT_NE(holder.get(), &routes);
+}
+
+TEST(ReplicatedServicesTest, ThreadsUseTheirShards) {
+    auto created  = 0;
+    auto services = ReplicatedServices<const C>{ ReplicatedHolder<const C>{
+        [&] {
+            ++created;
+            return C{};
+        },
+        ReplicaOptions{ .shards = 4, .by = ReplicaBy::thread } } };
+    EXPECT_EQ(created, 4);
+
+    auto const holder = services.get<C>();
+    EXPECT_EQ(holder.get(), holder.get()); // stable per thread
+
+    std::set<C const *> seen;
+    std::vector<C const *> copies(4);
+    std::vector<std::thread> threads;
+    for(auto t = 0; t < 4; ++t)
+        threads.emplace_back([&, t] { copies[t] = services.get<C>().get(); });
+    for(auto &t : threads)
+        t.join();
+    seen.insert(copies.begin(), copies.end());
+
+    EXPECT_EQ(seen.size(), 4); // four fresh threads get consecutive slots
+    for(auto copy : copies)
+        EXPECT_STREQ(copy->value.c_str(), "Unchanged");
+}
+
+TEST(ReplicatedServicesTest, SharingUsesTheShardControlBlock) {
+    auto services = ReplicatedServices<const C>{ ReplicatedHolder<const C>{ C{}, ReplicaOptions{ .shards = 1 } } };
+    auto holder   = services.get<C>();
+
+    auto shared = *holder;
+    static_assert(std::is_same_v<decltype(shared), std::shared_ptr<const C>>);
+    EXPECT_EQ(shared.get(), holder.get());
+    EXPECT_EQ(shared.use_count(), 2);
+}
+
+TEST(ReplicatedServicesTest, CopiesCountOnTheirShard) {
+    auto services = ReplicatedServices<const C>{ ReplicatedHolder<const C>{ C{}, ReplicaOptions{ .shards = 2, .by = ReplicaBy::thread } } };
+
+    std::latch copied{ 1 };
+    std::latch measured{ 1 };
+    long other_shard_count = 0;
+
+    // two fresh threads get consecutive slots, so different shards
+    std::thread holding([&] {
+        auto copies = std::vector<ReplicatedHolder<const C>>(3, services.get<C>());
+        copied.count_down();
+        measured.wait();
+    });
+    std::thread measuring([&] {
+        copied.wait();
+        other_shard_count = services.get<C>().use_count();
+        measured.count_down();
+    });
+    holding.join();
+    measuring.join();
+
+    EXPECT_LE(other_shard_count, 3); // the pin, maybe the selection's holder and itself; none of the copies
+}
+
+TEST(ReplicatedServicesTest, OutlivesTheCreatingHolder) {
+    ReplicatedServices<const C> narrowed = ReplicatedServices<const C>{ ReplicatedHolder<const C>{ C{}, ReplicaOptions{ .shards = 4 } } };
+    auto copy = narrowed.get<C>(); // no pinning holder is left
+    EXPECT_STREQ(copy->value.c_str(), "Unchanged");
+    EXPECT_STREQ(ReplicatedServices<const C>{ narrowed }.get<C>()->value.c_str(), "Unchanged");
+}
+
+TEST(ReplicatedServicesTest, CombinesWithOtherReplicatedServices) {
+    auto services = ReplicatedServices<const C, const D>{
+        ReplicatedHolder<const C>{ C{} },
+        ReplicatedHolder<const D>{ D{ 1.5f } },
+    };
+
+    ReplicatedServices<const D> narrowed = services;
+    EXPECT_EQ(narrowed.get<D>()->value, 1.5f);
+}
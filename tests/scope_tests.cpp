@@ -0,0 +1,77 @@
+#include "types.hpp"
+#include <di.hpp>
+
+#include <array>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace di;
+
+namespace {
+
+struct Tracked {
+    int &destroyed;
+    ~Tracked() { ++destroyed; }
+};
+
+bool inside(void const *ptr, std::span<std::byte> buffer) {
+    auto const p = static_cast<std::byte const *>(ptr);
+    return p >= buffer.data() and p < buffer.data() + buffer.size();
+}
+
+} // namespace
+
+TEST(ScopeTest, ServicesLiveInTheArena) {
+    alignas(std::max_align_t) std::array<std::byte, 4096> buffer;
+    Scope scope{ buffer };
+
+    {
+        auto scoped = scope.services<A, const C>();
+        static_assert(std::is_same_v<decltype(scoped), Services<A, const C>>);
+        EXPECT_TRUE(inside(scoped.get<A>().get(), buffer));
+        EXPECT_TRUE(inside(scoped.get<C>().get(), buffer));
+        EXPECT_STREQ(scoped.get<C>()->value.c_str(), "Unchanged");
+        EXPECT_EQ(scope.live(), 2);
+    }
+
+    EXPECT_EQ(scope.live(), 0);
+    scope.reset();
+}
+
+TEST(ScopeTest, CombinesWithParentServices) {
+    Services<Config, const B> singletons;
+    Scope scope;
+
+    {
+        auto request = combine(singletons, scope.services<A, C>());
+        static_assert(std::is_same_v<decltype(request), Services<Config, const B, A, C>>);
+
+        auto extended = extend(request, scope.create<D>(D{ 4.2f }));
+        static_assert(std::is_same_v<decltype(extended), Services<Config, const B, A, C, D>>);
+        EXPECT_EQ(extended.get<Config>(), singletons.get<Config>());
+        EXPECT_FLOAT_EQ(extended.get<D>()->value, 4.2f);
+        EXPECT_EQ(scope.live(), 3);
+    }
+
+    scope.reset();
+    EXPECT_EQ(singletons.get<Config>()->severity, 3); // singletons are unaffected
+}
+
+TEST(ScopeTest, ReusedAfterReset) {
+    alignas(std::max_align_t) std::array<std::byte, 1024> buffer;
+    Scope scope{ buffer };
+    auto destroyed = 0;
+
+    void *first = nullptr;
+    for(auto i = 0; i < 3; ++i) {
+        {
+            auto tracked = scope.create<Tracked>(destroyed);
+            if(i == 0)
+                first = tracked.get();
+            EXPECT_EQ(tracked.get(), first); // same memory each request
+        }
+        scope.reset();
+    }
+    EXPECT_EQ(destroyed, 3);
+}
@@ -0,0 +1,75 @@
+#include "types.hpp"
+#include <di.hpp>
+
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace di;
+
+TEST(SelectionViewTest, CompileChecks) {
+    Services<A, B, const C> services;
+    [[maybe_unused]] SelectionView<A, const B> valid1 = services; // narrowing + const promotion
+    [[maybe_unused]] SelectionView<const A> valid2    = valid1;   // narrowing a view
+    [[maybe_unused]] SelectionView<const C> valid3    = services;
+    static_assert(std::is_same_v<decltype(valid1.get<A>()), ViewHolder<A>>);
+    static_assert(std::is_same_v<decltype(valid1.get<B>()), ViewHolder<const B>>);
+    static_assert(std::is_same_v<decltype(valid2.get<A>()), ViewHolder<const A>>);
+    static_assert(std::is_same_v<decltype(valid3.get<C>()), ViewHolder<const C>>);
+    static_assert(sizeof(SelectionView<A, const B>) == 2 * sizeof(void *)); // just the pointers
+    static_assert(not std::is_constructible_v<SelectionView<A>, Services<A>>); // would dangle
+    static_assert(not std::is_convertible_v<Services<A, B>, SelectionView<const A>>);
+    static_assert(std::is_constructible_v<SelectionView<const A>, SelectionView<A, B>>); // views can be narrowed from temporaries
+
+    // [[maybe_unused]] SelectionView<C> invalid = services; - can't bind non-const C
+    // [[maybe_unused]] SelectionView<D> invalid = services; - no D in services
+    // [[maybe_unused]] SelectionView<A, A> invalid; - duplicates
+}
+
+TEST(SelectionViewTest, BorrowsFromServices) {
+    Services<A, B, Config> services;
+    SelectionView<A, const Config> view = services;
+
+    auto a = services.get<A>();
+    EXPECT_EQ(a.use_count(), 2); // services and a, none for the view
+    EXPECT_EQ(view.get<A>().get(), a.get());
+
+    view.get<A>()->value = 42;
+    EXPECT_EQ(services.get<A>()->value, 42);
+    EXPECT_EQ(view.get<Config>()->severity, 3);
+}
+
+TEST(SelectionViewTest, BorrowsFromDeps) {
+    A a;
+    B b;
+    Deps<A, B> deps{ a, b };
+    SelectionView<const A, B> view = deps;
+
+    EXPECT_EQ(view.get<A>().get(), &a);
+    EXPECT_EQ(&*view.get<B>(), &b);
+}
+
+TEST(SelectionViewTest, BorrowsFromLazyServices) {
+    auto a_created = false;
+    auto services  = LazyServices<A, B>{
+        [&a_created] {
+            a_created = true;
+            return A{};
+        },
+        std::make_shared<B>()
+    };
+
+    SelectionView<const A> view = services; // resolves A
+    EXPECT_TRUE(a_created);
+    EXPECT_EQ(view.get<A>().get(), services.get<A>().operator->());
+}
+
+TEST(SelectionViewTest, ConstructedFromReferences) {
+    A a;
+    const B b;
+    SelectionView<A, const B> view{ a, b };
+    auto [va, vb] = view.get<A, const B>();
+
+    va->value = 1;
+    EXPECT_EQ(a.value, 1);
+    EXPECT_EQ(vb.get(), &b);
+}
@@ -0,0 +1,105 @@
+#include <di.hpp>
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace di;
+
+namespace {
+
+struct Limits {
+    long per_second = 10;
+    long burst      = -10; // always -per_second
+};
+
+struct Odd {
+    char bytes[3] = { 1, 2, 3 };
+};
+
+// padding after flag, and no default constructor
+struct Padded {
+    bool flag;
+    double ratio;
+
+    Padded(bool f, double r)
+        : flag{ f }
+        , ratio{ r } {}
+};
+
+template <typename Holder>
+concept Writable = requires(Holder holder) {
+    holder.store(Limits{});
+};
+
+} // namespace
+
+static_assert(Writable<SeqLockHolder<Limits>>);
+static_assert(not Writable<SeqLockHolder<const Limits>>);
+
+TEST(SeqLockServicesTest, LoadsAndStores) {
+    auto services = SeqLockServices<Limits, Odd>{};
+    auto limits   = services.get<Limits>();
+    EXPECT_EQ(limits->per_second, 10);
+
+    limits.store(Limits{ 20, -20 });
+    EXPECT_EQ(services.get<Limits>().load().burst, -20); // copies share the value
+
+    limits.update([](Limits &l) { l.per_second += 1; });
+    EXPECT_EQ((*limits).per_second, 21);
+
+    EXPECT_EQ(services.get<Odd>()->bytes[2], 3);
+}
+
+TEST(SeqLockServicesTest, ConstIsReadOnly) {
+    auto services = SeqLockServices<Limits>{};
+    auto readonly = SeqLockServices<const Limits>{ services };
+
+    services.get<Limits>().store(Limits{ 5, -5 });
+    EXPECT_EQ(readonly.get<Limits>()->per_second, 5);
+    EXPECT_EQ(services.get<const Limits>()->burst, -5);
+}
+
+TEST(SeqLockServicesTest, CopiesPaddedValues) {
+    auto holder = SeqLockHolder<Padded>{ Padded{ true, 0.5 } };
+    holder.update([](Padded &p) { p.ratio *= 3; });
+
+    auto const value = holder.load();
+    EXPECT_TRUE(value.flag);
+    EXPECT_EQ(value.ratio, 1.5);
+}
+
+TEST(SeqLockServicesTest, ReadersSeeConsistentCopies) {
+    auto services          = SeqLockServices<Limits>{};
+    std::atomic<bool> done = false;
+    std::atomic<int> torn  = 0;
+
+    std::vector<std::thread> readers;
+    for(auto t = 0; t < 4; ++t)
+        readers.emplace_back([&, holder = SeqLockServices<const Limits>{ services }.get<Limits>()] {
+            while(not done) {
+                auto const limits = holder.load();
+                if(limits.burst != -limits.per_second)
+                    ++torn;
+            }
+        });
+
+    std::vector<std::thread> writers;
+    for(auto t = 0; t < 2; ++t)
+        writers.emplace_back([holder = services.get<Limits>()]() mutable {
+            for(auto i = 0; i < 5000; ++i)
+                holder.update([](Limits &l) {
+                    l.per_second += 1;
+                    l.burst = -l.per_second;
+                });
+        });
+    for(auto &writer : writers)
+        writer.join();
+    done = true;
+    for(auto &reader : readers)
+        reader.join();
+
+    EXPECT_EQ(torn, 0);
+    EXPECT_EQ(services.get<Limits>()->per_second, 10 + 2 * 5000); // no update lost
+}
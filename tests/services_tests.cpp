@@ -11,6 +11,12 @@ TEST(ServicesTest, CompileChecks) {
     [[maybe_unused]] Services<B, A, C> valid2;
     [[maybe_unused]] Services<const A, const B> valid3; // only const get possible
 
+    static_assert(index_in<B, A, B, C> == 1);
+    static_assert(index_in<const C, A, B, const C> == 2);
+    static_assert(check_unique<A, B, const A>::value);
+    static_assert(not check_unique<A, B, A>::value);
+    static_assert(not MappedOnce<C, type_index_map<A, B>>);
+
     // Services<const A, B> s = valid3; // invalid - can't bind non-const B
     // [[maybe_unused]] Services<A, B, B> invalid - duplicates
     // [[maybe_unused]] Services<B, A, B> invalid - duplicates
@@ -82,6 +88,50 @@ TEST(ServicesTest, Combining) {
     // auto fail1 = combine(comb5, ab); // can't add A and B because they already exist in comb5
 }
 
+TEST(ServicesTest, MovingOutOfExpiringSelections) {
+    Services<A, B, C> abc;
+    auto const a = abc.get<A>().get();
+    auto const c = abc.get<C>().get();
+
+    Services<A, const B> narrowed = std::move(abc);
+    EXPECT_EQ(narrowed.get<A>().get(), a);
+    EXPECT_EQ(narrowed.get<A>().use_count(), 2); // narrowed + the returned copy
+    EXPECT_EQ(abc.get<A>(), nullptr);             // moved out
+    EXPECT_EQ(abc.get<C>().get(), c);             // not selected, left untouched
+
+    auto extended = extend(std::move(narrowed), std::make_shared<Config>());
+    static_assert(std::is_same_v<decltype(extended), Services<A, const B, Config>>);
+    EXPECT_EQ(narrowed.get<A>(), nullptr);
+    EXPECT_EQ(extended.get<A>().use_count(), 2);
+
+    auto [moved_a, moved_b] = std::move(extended).get<A, const B>();
+    static_assert(std::is_same_v<decltype(moved_b), std::shared_ptr<const B>>);
+    EXPECT_EQ(moved_a.get(), a);
+    EXPECT_EQ(moved_a.use_count(), 1);
+}
+
+TEST(ServicesTest, CombiningInOnePass) {
+    Services<A, B> ab;
+    Services<C> c;
+    Services<const D> d;
+
+    auto copied = combine(ab, c, d);
+    static_assert(std::is_same_v<decltype(copied), Services<A, B, C, const D>>);
+    EXPECT_EQ(ab.get<A>().use_count(), 3); // ab, copied and the returned copy
+
+    auto moved = combine(std::move(ab), Services<Config>{}, std::move(d), c);
+    static_assert(std::is_same_v<decltype(moved), Services<A, B, Config, const D, C>>);
+    EXPECT_EQ(ab.get<A>(), nullptr);
+    EXPECT_EQ(d.get<D>(), nullptr);
+    EXPECT_NE(c.get<C>(), nullptr);
+    EXPECT_EQ(moved.get<A>().get(), copied.get<A>().get());
+
+    Deps<A> deps_a{ *moved.get<A>() };
+    Deps<C> deps_c{ *moved.get<C>() };
+    auto deps = combine(deps_a, std::move(deps_c));
+    static_assert(std::is_same_v<decltype(deps), Deps<A, C>>);
+}
+
 TEST(ServicesTest, UsingStructuredBindings) {
     Services<A, B, C> abc;
     auto [a, b] = abc.get<A, const B>();
@@ -113,4 +163,26 @@ TEST(ServicesTest, FreeFunctionTupleGet) {
     auto [a, b] = get<A, const B>(abc);
     static_assert(std::is_same_v<decltype(a), std::shared_ptr<A>>);
     static_assert(std::is_same_v<decltype(b), std::shared_ptr<const B>>);
-}
\ No newline at end of file
+}
+
+TEST(ServicesTest, ArenaConstruction) {
+    auto services = Services<A, const B, C>{ in_arena };
+    auto a        = services.get<A>();
+    auto b        = services.get<B>();
+    static_assert(std::is_same_v<decltype(b), std::shared_ptr<const B>>);
+
+    EXPECT_EQ(a->value, 1234);
+    EXPECT_FALSE(b->value);
+    EXPECT_STREQ(services.get<C>()->value.c_str(), "Unchanged");
+
+    // all services share one control block
+    EXPECT_FALSE(a.owner_before(b) or b.owner_before(a));
+    EXPECT_EQ(a.use_count(), 5); // 3 aliases in services, a and b
+
+    // narrowing keeps the arena alive
+    Services<const C> c = services;
+    services            = Services<A, const B, C>{ in_arena };
+    a.reset();
+    b.reset();
+    EXPECT_STREQ(c.get<C>()->value.c_str(), "Unchanged");
+}
@@ -0,0 +1,92 @@
+#include <di.hpp>
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace di;
+
+namespace {
+
+// own types: static instances are shared by the whole test binary
+struct Counter {
+    int value = 0;
+};
+
+struct Settings {
+    int severity = 3;
+};
+
+struct Named {
+    std::string name = "a name too long for the small string buffer";
+};
+
+struct Consumer {
+    using services_t = Services<Counter, const Settings>;
+    services_t services;
+};
+
+struct DepsConsumer {
+    using services_t = Deps<const Counter>;
+    services_t services;
+};
+
+constinit auto global_services = StaticServices<Counter, const Settings, Named>{};
+
+} // namespace
+
+TEST(StaticServicesTest, CompileChecks) {
+    static_assert(detail::ConstantInitializable<Counter>);
+    static_assert(not detail::ConstantInitializable<Named>);
+
+    StaticServices<Counter, Settings> services;
+    [[maybe_unused]] StaticServices<const Counter> valid1 = services; // narrowing + const promotion
+    [[maybe_unused]] SelectionView<const Settings> valid2 = services; // views borrow from it
+    static_assert(std::is_same_v<decltype(valid1.get<Counter>()), StaticHolder<const Counter>>);
+    static_assert(std::is_empty_v<StaticHolder<Counter>>);
+    static_assert(std::is_constructible_v<Services<const Counter>, StaticServices<Counter, Settings>>);
+    static_assert(not std::is_constructible_v<Services<Counter>, StaticServices<const Counter>>);
+    static_assert(not std::is_constructible_v<StaticServices<Counter>, Services<Counter>>);
+
+    // [[maybe_unused]] StaticServices<Counter> invalid = valid1; - can't bind non-const Counter
+    // [[maybe_unused]] StaticServices<Counter, Counter> invalid; - duplicates
+}
+
+TEST(StaticServicesTest, SharesOneInstancePerType) {
+    global_services.get<Counter>()->value = 0;
+
+    StaticServices<Counter> other;
+    other.get<Counter>()->value += 2;
+
+    EXPECT_EQ(global_services.get<Counter>().get(), other.get<Counter>().get());
+    EXPECT_EQ(global_services.get<const Counter>()->value, 2);
+}
+
+TEST(StaticServicesTest, ConvertsToServicesAndDeps) {
+    global_services.get<Counter>()->value = 5;
+
+    auto consumer = Consumer{ global_services };
+    auto counter  = consumer.services.get<Counter>();
+    EXPECT_EQ(counter.get(), global_services.get<Counter>().get());
+    EXPECT_EQ(counter.use_count(), 0); // not owned, nothing counted
+    EXPECT_EQ(consumer.services.get<Settings>()->severity, 3);
+
+    auto deps = DepsConsumer{ global_services };
+    EXPECT_EQ(deps.services.get<Counter>().get().value, 5);
+}
+
+TEST(StaticServicesTest, ConstructsOtherTypesOnFirstAccess) {
+    auto named = global_services.get<Named>();
+    EXPECT_EQ((*named).name, "a name too long for the small string buffer");
+
+    std::vector<std::thread> threads;
+    std::vector<Named *> seen(4);
+    for(auto t = 0; t < 4; ++t)
+        threads.emplace_back([&seen, t] { seen[t] = StaticServices<Named>{}.get<Named>().get(); });
+    for(auto &thread : threads)
+        thread.join();
+
+    for(auto ptr : seen)
+        EXPECT_EQ(ptr, named.get());
+}
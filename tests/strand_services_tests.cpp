@@ -0,0 +1,85 @@
+#include <di.hpp>
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace di;
+
+namespace {
+
+// not thread-safe on purpose
+struct Protocol {
+    long packets = 0;
+    std::vector<int> order;
+
+    long receive() { return ++packets; }
+};
+
+} // namespace
+
+TEST(StrandServicesTest, SerializesPostedCalls) {
+    auto services = StrandServices<Protocol>{};
+
+    std::vector<std::thread> threads;
+    for(auto t = 0; t < 4; ++t)
+        threads.emplace_back([holder = services.get<Protocol>()] {
+            for(auto i = 0; i < 1000; ++i)
+                holder.post([](Protocol &p) { p.receive(); });
+        });
+    for(auto &thread : threads)
+        thread.join();
+
+    EXPECT_EQ(services.get<Protocol>().call([](Protocol &p) { return p.packets; }).get(), 4000);
+}
+
+TEST(StrandServicesTest, KeepsOrderOfOneThread) {
+    auto holder = StrandHolder<Protocol>{ Protocol{} };
+    for(auto i = 0; i < 5; ++i)
+        holder.post([i](Protocol &p) { p.order.push_back(i); });
+
+    auto const order = holder.call([](Protocol &p) { return p.order; }).get();
+    EXPECT_EQ(order, (std::vector<int>{ 0, 1, 2, 3, 4 }));
+}
+
+TEST(StrandServicesTest, DeliversResultsAndErrors) {
+    auto holder = StrandHolder<Protocol>{ Protocol{} };
+    EXPECT_EQ(holder.call([](Protocol &p) { return p.receive(); }).get(), 1);
+
+    auto failed = holder.call([](Protocol &) -> int { throw std::runtime_error("broken"); });
+    EXPECT_THROW(failed.get(), std::runtime_error);
+
+    holder.call([](Protocol &p) { p.receive(); }).get(); // still usable
+    EXPECT_EQ(holder.call([](Protocol &p) { return p.packets; }).get(), 2);
+}
+
+TEST(StrandServicesTest, RunsOnExecutor) {
+    ThreadPool pool{ 2 };
+    auto holder = StrandHolder<Protocol>{ Protocol{}, pool };
+    auto caller = std::this_thread::get_id();
+
+    auto ran_on = holder.call([](Protocol &) { return std::this_thread::get_id(); }).get();
+    EXPECT_NE(ran_on, caller);
+}
+
+TEST(StrandServicesTest, AwaitsCalls) {
+    ThreadPool pool{ 2 };
+    auto services = StrandServices<Protocol>{ StrandHolder<Protocol>{ Protocol{}, pool } };
+
+    auto task = [](StrandServices<Protocol> services) -> Task<long> {
+        auto holder = services.get<Protocol>();
+        co_await holder.async([](Protocol &p) { p.receive(); });
+        co_return co_await holder.async([](Protocol &p) { return p.receive(); });
+    };
+    EXPECT_EQ(sync_wait(task(services)), 2);
+}
+
+TEST(StrandServicesTest, PromotesToConst) {
+    auto services = StrandServices<Protocol>{};
+    auto readonly = StrandServices<const Protocol>{ services };
+
+    services.get<Protocol>().post([](Protocol &p) { p.receive(); });
+    EXPECT_EQ(readonly.get<Protocol>().call([](Protocol const &p) { return p.packets; }).get(), 1);
+}
@@ -0,0 +1,163 @@
+#include <di.hpp>
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace di;
+
+namespace {
+
+std::atomic<int> alive = 0;
+
+struct Settings {
+    int version = 0;
+    int doubled = 0; // always 2 * version in a published instance
+
+    Settings() { ++alive; }
+    Settings(int v)
+        : version{ v }
+        , doubled{ 2 * v } { ++alive; }
+    Settings(Settings const &other)
+        : version{ other.version }
+        , doubled{ other.doubled } { ++alive; }
+    Settings &operator=(Settings const &) = default;
+    ~Settings() { --alive; }
+};
+
+} // namespace
+
+TEST(SwappableServicesTest, PublishesNewInstances) {
+    {
+        auto services = SwappableServices<Settings>{};
+        auto holder   = services.get<Settings>();
+        EXPECT_EQ(holder->version, 0);
+
+        holder.publish(Settings{ 1 });
+        EXPECT_EQ(services.get<Settings>()->version, 1); // copies share the state
+        EXPECT_EQ(holder.retired(), 0);                // nobody was reading
+
+        holder.update([](Settings &config) { config = Settings{ config.version + 1 }; });
+        EXPECT_EQ(holder->doubled, 4);
+    }
+    EXPECT_EQ(alive, 0);
+}
+
+TEST(SwappableServicesTest, KeepsInstancesWhileRead) {
+    {
+        auto holder   = SwappableHolder<const Settings>{ Settings{ 1 } };
+        auto services = SwappableServices<const Settings>{ holder };
+        {
+            auto snapshot = services.get<Settings>().read();
+            holder.publish(Settings{ 2 });
+            EXPECT_EQ(snapshot->version, 1); // still the old instance
+            EXPECT_EQ(holder->version, 2);
+            EXPECT_EQ(holder.retired(), 1);
+        }
+        holder.publish(Settings{ 3 });
+        EXPECT_EQ(holder.retired(), 0); // both old instances reclaimed
+        EXPECT_EQ(alive, 1);
+    }
+    EXPECT_EQ(alive, 0);
+}
+
+TEST(SwappableServicesTest, ReclaimsWithoutPublishing) {
+    auto holder = SwappableHolder<const Settings>{ Settings{ 1 } };
+    {
+        auto snapshot = holder.read();
+        holder.publish(Settings{ 2 });
+        EXPECT_EQ(holder.reclaim(), 1); // still read
+        EXPECT_EQ(snapshot->version, 1);
+    }
+    EXPECT_EQ(holder.reclaim(), 0);
+    EXPECT_EQ(holder.retired(), 0);
+    EXPECT_EQ(alive, 1);
+}
+
+TEST(SwappableServicesTest, PromotesToConst) {
+    auto services = SwappableServices<Settings>{};
+    auto readonly = SwappableServices<const Settings>{ services };
+
+    services.get<Settings>().publish(Settings{ 5 });
+    EXPECT_EQ(readonly.get<Settings>()->version, 5);
+}
+
+// run with ENABLE_TSAN to check the reclamation for races
+TEST(SwappableServicesTest, StressReadersAgainstSwaps) {
+    {
+        auto services = SwappableServices<const Settings>{ SwappableHolder<const Settings>{ Settings{ 0 } } };
+        std::atomic<bool> done = false;
+        std::atomic<int> inconsistent = 0;
+
+        std::vector<std::thread> readers;
+        for(auto t = 0; t < 4; ++t)
+            readers.emplace_back([&, holder = services.get<Settings>()] {
+                auto last = 0;
+                while(not done) {
+                    auto snapshot = holder.read();
+                    if(snapshot->doubled != 2 * snapshot->version or snapshot->version < last)
+                        ++inconsistent;
+                    last = snapshot->version;
+                }
+            });
+
+        auto writer = services.get<Settings>();
+        for(auto v = 1; v <= 2000; ++v) {
+            if(v % 2)
+                writer.publish(Settings{ v });
+            else
+                writer.update([](Settings &config) { config = Settings{ config.version + 1 }; });
+        }
+        done = true;
+        for(auto &reader : readers)
+            reader.join();
+
+        EXPECT_EQ(inconsistent, 0);
+        EXPECT_EQ(writer->version, 2000);
+    }
+    EXPECT_EQ(alive, 0);
+}
+
+// run with ENABLE_TSAN (or ENABLE_ASAN) to check that no instance is deleted while read
+TEST(SwappableServicesTest, StressReclamationWithManyWriters) {
+    {
+        auto holder            = SwappableHolder<const Settings>{ Settings{ 0 } };
+        std::atomic<bool> done = false;
+        std::atomic<int> inconsistent = 0;
+
+        std::vector<std::thread> writers;
+        for(auto t = 0; t < 2; ++t)
+            writers.emplace_back([&, holder]() mutable {
+                for(auto v = 1; v <= 10000; ++v)
+                    holder.publish(Settings{ v });
+            });
+
+        std::vector<std::thread> readers;
+        for(auto t = 0; t < 4; ++t)
+            readers.emplace_back([&, holder] {
+                while(not done) {
+                    // short-lived threads reuse the reader records of finished ones
+                    std::thread([&, holder] {
+                        for(auto i = 0; i < 100; ++i) {
+                            auto outer = holder.read();
+                            std::this_thread::yield(); // let writers swap and reclaim meanwhile
+                            auto inner = holder.read();
+                            if(outer->doubled != 2 * outer->version or inner->doubled != 2 * inner->version)
+                                ++inconsistent;
+                        }
+                    }).join();
+                }
+            });
+
+        for(auto &writer : writers)
+            writer.join();
+        done = true;
+        for(auto &reader : readers)
+            reader.join();
+
+        EXPECT_EQ(inconsistent, 0);
+        EXPECT_EQ(holder->version, 10000);
+    }
+    EXPECT_EQ(alive, 0);
+}
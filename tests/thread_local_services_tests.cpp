@@ -0,0 +1,68 @@
+#include "types.hpp"
+#include <di.hpp>
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace di;
+
+namespace {
+
+struct Counter {
+    int hits = 0;
+};
+
+} // namespace
+
+TEST(ThreadLocalServicesTest, OneInstancePerThread) {
+    auto services = ThreadLocalServices<Counter>{ [] { return Counter{}; } };
+    auto holder   = services.get<Counter>();
+
+    EXPECT_EQ(holder.instances(), 0);
+    auto const main = holder.get();
+    EXPECT_EQ(services.get<Counter>().get(), main); // copies share instances
+    EXPECT_EQ(holder.instances(), 1);
+
+    Counter *other = nullptr;
+    std::thread([&] { other = services.get<Counter>().get(); }).join();
+    EXPECT_NE(other, main);
+    EXPECT_EQ(holder.instances(), 2);
+}
+
+TEST(ThreadLocalServicesTest, MergesCountersOfAllThreads) {
+    auto services = ThreadLocalServices<Counter>{ [] { return std::make_shared<Counter>(); } };
+
+    std::vector<std::thread> threads;
+    for(auto t = 0; t < 4; ++t)
+        threads.emplace_back([services] {
+            for(auto i = 0; i < 1000; ++i)
+                services.get<Counter>()->hits++;
+        });
+    for(auto &t : threads)
+        t.join();
+
+    auto total = 0;
+    services.get<Counter>().for_each([&](Counter const &c) { total += c.hits; });
+    EXPECT_EQ(total, 4000);
+    EXPECT_EQ(services.get<Counter>().instances(), 4);
+}
+
+TEST(ThreadLocalServicesTest, IndependentHoldersAndConstPromotion) {
+    auto first  = ThreadLocalServices<Counter>{ [] { return Counter{ 1 }; } };
+    auto second = ThreadLocalServices<Counter>{ [] { return Counter{ 2 }; } };
+
+    EXPECT_EQ(first.get<Counter>()->hits, 1);
+    EXPECT_EQ(second.get<Counter>()->hits, 2);
+
+    ThreadLocalServices<const Counter> readonly = first;
+    static_assert(std::is_same_v<decltype(readonly.get<Counter>().get()), Counter const *>);
+    EXPECT_EQ(readonly.get<Counter>().get(), first.get<Counter>().get());
+}
+
+TEST(ThreadLocalServicesTest, RecreatedHolderGetsFreshInstances) {
+    for(auto i = 0; i < 3; ++i) {
+        auto services = ThreadLocalServices<Counter>{ [i] { return Counter{ i }; } };
+        EXPECT_EQ(services.get<Counter>()->hits, i);
+    }
+}
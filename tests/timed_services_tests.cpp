@@ -0,0 +1,125 @@
+#include "types.hpp"
+#include <di.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace di;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Clock {
+    int ticks = 0;
+    int tick() { return ++ticks; }
+    int now() const { return ticks; }
+};
+
+struct Sleeper {
+    void sleep() const { std::this_thread::sleep_for(1ms); }
+};
+
+struct Shared {
+    int value = 0;
+    void add() { ++value; }
+};
+
+struct Churned {
+    int value = 0;
+};
+
+struct Referenced {
+    int value = 7;
+    int get() const { return value; }
+};
+
+} // namespace
+
+TEST(TimedServicesTest, TimesEachCall) {
+    reset_latency();
+    auto services = TimedServices<Clock, const Sleeper>{};
+
+    EXPECT_EQ(services.get<Clock>()->tick(), 1);
+    EXPECT_EQ(services.get<Clock>()->tick(), 2);
+    services.get<Sleeper>()->sleep();
+    EXPECT_EQ(services.get<Clock>().get()->now(), 2); // untimed
+
+    auto const clock = latency_snapshot<Clock>();
+    EXPECT_EQ(clock.calls, 2);
+
+    auto const sleeper = latency_snapshot<const Sleeper>();
+    EXPECT_EQ(sleeper.calls, 1);
+    EXPECT_GE(sleeper.max_ns, std::chrono::nanoseconds(1ms).count());
+    EXPECT_GE(sleeper.percentile(0.5), std::chrono::nanoseconds(1ms).count() / 2);
+    EXPECT_LE(sleeper.percentile(0.5), sleeper.max_ns);
+}
+
+TEST(TimedServicesTest, SamplesCalls) {
+    reset_latency();
+    set_latency_sampling(4);
+    auto services = TimedServices<Clock>{};
+    for(auto i = 0; i < 100; ++i)
+        services.get<Clock>()->tick();
+    set_latency_sampling(0);
+    for(auto i = 0; i < 100; ++i)
+        services.get<Clock>()->tick();
+    set_latency_sampling(1);
+
+    EXPECT_EQ(services.get<Clock>()->now(), 200);
+    EXPECT_EQ(latency_snapshot<Clock>().calls, 25 + 1);
+}
+
+TEST(TimedServicesTest, MergesThreads) {
+    reset_latency();
+    auto services = TimedServices<Shared>{};
+
+    std::vector<std::thread> threads;
+    for(auto t = 0; t < 4; ++t)
+        threads.emplace_back([holder = services.get<Shared>()] {
+            for(auto i = 0; i < 100; ++i)
+                [[maybe_unused]] auto value = holder->value;
+        });
+    for(auto &thread : threads)
+        thread.join();
+
+    auto const histogram = latency_snapshot<Shared>();
+    EXPECT_EQ(histogram.calls, 400);
+
+    std::uint64_t bucketed = 0;
+    for(auto count : histogram.buckets)
+        bucketed += count;
+    EXPECT_EQ(bucketed, 400);
+
+    auto const all = latency_snapshots();
+    auto const it  = std::find_if(all.begin(), all.end(), [](auto const &entry) { return entry.first == detail::type_name<Shared>(); });
+    ASSERT_NE(it, all.end());
+    EXPECT_EQ(it->second.calls, 400);
+}
+
+TEST(TimedServicesTest, ReusesHistogramsOfFinishedThreads) {
+    auto services = TimedServices<Churned>{};
+    for(auto t = 0; t < 50; ++t) // one short-lived thread after the other
+        std::thread([holder = services.get<Churned>()] { [[maybe_unused]] auto value = holder->value; }).join();
+
+    std::size_t histograms = 0;
+    detail::latency_registry::instance().for_each([&](detail::thread_latency const &local) {
+        histograms += local.key == &detail::latency_key<Churned>;
+    });
+    EXPECT_EQ(histograms, 1);
+    EXPECT_EQ(latency_snapshot<Churned>().calls, 50); // counts of finished threads are kept
+}
+
+TEST(TimedServicesTest, WrapsReferencesAndPromotesToConst) {
+    reset_latency();
+    Referenced referenced;
+    auto services = TimedServices<Referenced>{ std::ref(referenced) };
+    auto readonly = TimedServices<const Referenced>{ services };
+
+    EXPECT_EQ(readonly.get<Referenced>()->get(), 7);
+    EXPECT_EQ(readonly.get<Referenced>().get(), &referenced);
+    EXPECT_EQ(latency_snapshot<Referenced>().calls, 1);
+}
@@ -0,0 +1,108 @@
+#include "types.hpp"
+#include <di.hpp>
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace di;
+
+namespace {
+
+struct Leaf {};
+
+struct Branch {
+    using services_t = Services<Leaf>;
+    Branch(services_t services)
+        : services_{ services } {}
+    services_t services_;
+};
+
+std::vector<std::string> phases(TraceRecorder const &recorder) {
+    std::vector<std::string> result;
+    for(auto const &event : recorder.events())
+        result.push_back(std::string{ event.phase } + ' ' + std::string{ event.name });
+    return result;
+}
+
+} // namespace
+
+TEST(TraceTest, RecordsNothingWithoutRecorder) {
+    TraceRecorder recorder;
+    auto services = Services<A, B>{};
+    {
+        ScopedTrace tracing{ recorder };
+    }
+    auto more = Services<C>{};
+    EXPECT_TRUE(recorder.events().empty());
+}
+
+TEST(TraceTest, RecordsDefaultConstruction) {
+    TraceRecorder recorder;
+    {
+        ScopedTrace tracing{ recorder };
+        auto services = Services<A, const B>{};
+    }
+
+    auto const events = recorder.events();
+    ASSERT_EQ(events.size(), 4);
+    EXPECT_EQ(events[0].name, detail::type_name<A>());
+    EXPECT_EQ(events[0].category, "services");
+    EXPECT_EQ(events[0].phase, 'B');
+    EXPECT_EQ(events[1].phase, 'E');
+    EXPECT_EQ(events[2].name, detail::type_name<B>()); // traced without const
+    EXPECT_LE(events[0].ts_ns, events[1].ts_ns);
+}
+
+TEST(TraceTest, NestsFactoriesResolvingOtherServices) {
+    auto leaves   = LazyServices<Leaf>{ [] { return Leaf{}; } };
+    auto branches = LazyServices<Branch>{ [leaves] {
+        return Branch{ Services<Leaf>{ *leaves.get<Leaf>() } };
+    } };
+
+    TraceRecorder recorder;
+    {
+        ScopedTrace tracing{ recorder };
+        [[maybe_unused]] auto branch = branches.get<Branch>().operator->();
+    }
+
+    auto const leaf   = std::string{ detail::type_name<Leaf>() };
+    auto const branch = std::string{ detail::type_name<Branch>() };
+    EXPECT_EQ(phases(recorder), (std::vector<std::string>{ "B " + branch, "B " + leaf, "E " + leaf, "E " + branch }));
+    EXPECT_EQ(recorder.events()[0].category, "lazy");
+}
+
+TEST(TraceTest, RecordsInjectorOnItsThreads) {
+    TraceRecorder recorder;
+    {
+        ScopedTrace tracing{ recorder };
+        ThreadPool pool{ 2 };
+        auto services = Injector<Branch>::build(pool);
+    }
+
+    auto const events = recorder.events();
+    ASSERT_EQ(events.size(), 6);
+    EXPECT_EQ(events.front().name, "Injector::build");
+    EXPECT_EQ(events.back().name, "Injector::build");
+    for(auto const &event : events)
+        EXPECT_EQ(event.category, "injector");
+    EXPECT_NE(events[1].tid, events.front().tid); // constructed on the pool
+}
+
+TEST(TraceTest, WritesChromeTraceFormat) {
+    TraceRecorder recorder;
+    {
+        ScopedTrace tracing{ recorder };
+        auto services = Services<A>{};
+    }
+
+    std::ostringstream out;
+    recorder.write(out);
+    auto const json = out.str();
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\": \"ns\", \"traceEvents\": [", 0), 0);
+    EXPECT_NE(json.find("\"ph\": \"B\""), std::string::npos);
+    EXPECT_NE(json.find("\"ph\": \"E\""), std::string::npos);
+    EXPECT_NE(json.find("\"cat\": \"services\""), std::string::npos);
+    EXPECT_NE(json.find("\"pid\": 1, \"tid\": "), std::string::npos);
+}